@@ -150,7 +150,7 @@ get_mult(char symbol, int *resp)
 
 /* ////////////////////////////////////////////////////////////////////////// */
 static int
-get_msg_size(const char *str, const char *label, int *real_msg_size)
+get_msg_size(const char *str, const char *label, size_t *real_msg_size)
 {
     long unit_size = -1;
     /* default multiplier is 1 (B) */
@@ -188,12 +188,12 @@ get_msg_size(const char *str, const char *label, int *real_msg_size)
         m = (uint64_t)mult;
         /* what is the real message size (B) */
         tmp = (us * m);
-        if (tmp > INT_MAX || tmp < us || tmp < m) {
+        if ((0 != us && tmp / us != m) || (uint64_t)(size_t)tmp != tmp) {
             SMGC_ERR_MSG("requested %s size is too large.\n", label);
             return SMGC_ERROR;
         }
         else {
-            *real_msg_size = (int)tmp;
+            *real_msg_size = (size_t)tmp;
         }
         return SMGC_SUCCESS;
     }
@@ -201,6 +201,249 @@ get_msg_size(const char *str, const char *label, int *real_msg_size)
     return SMGC_ERROR;
 }
 
+/* ////////////////////////////////////////////////////////////////////////// */
+/**
+ * parses a message size sweep specification of the form min:max:factor, where
+ * min and max accept the same unit suffixes as -m (e.g. 1:4M:2).
+ */
+static int
+get_sweep_params(const char *str)
+{
+    char *tmp_str = NULL, *min_str = NULL, *max_str = NULL, *fac_str = NULL;
+    char *last = NULL, *end_ptr = NULL;
+    int rc = SMGC_ERROR;
+    size_t min = 0, max = 0;
+    long factor = 0;
+
+    if (NULL == (tmp_str = strdup(str))) {
+        SMGC_ERR_MSG("out of resources\n");
+        return SMGC_ERROR;
+    }
+    if (NULL == (min_str = strtok_r(tmp_str, ":", &last)) ||
+        NULL == (max_str = strtok_r(NULL, ":", &last)) ||
+        NULL == (fac_str = strtok_r(NULL, ":", &last))) {
+        SMGC_ERR_MSG("invalid sweep specification: %s "
+                     "(expecting min:max:factor)\n", str);
+        goto out;
+    }
+    if (SMGC_SUCCESS != get_msg_size(min_str, "sweep minimum", &min) ||
+        SMGC_SUCCESS != get_msg_size(max_str, "sweep maximum", &max)) {
+        goto out;
+    }
+    errno = 0;
+    factor = strtol(fac_str, &end_ptr, 10);
+    if (0 != errno || '\0' != *end_ptr || factor < 2 || factor > INT_MAX) {
+        SMGC_ERR_MSG("invalid sweep factor: %s (must be an integer >= 2)\n",
+                     fac_str);
+        goto out;
+    }
+    /* sweeps use int counts */
+    if (0 == min || max < min || max > INT_MAX) {
+        SMGC_ERR_MSG("invalid sweep range: %lu B to %lu B\n",
+                     (unsigned long)min, (unsigned long)max);
+        goto out;
+    }
+
+    sweep_min = (int)min;
+    sweep_max = (int)max;
+    sweep_factor = (int)factor;
+    do_sweep = true;
+    rc = SMGC_SUCCESS;
+out:
+    free(tmp_str);
+    return rc;
+}
+
+/* ////////////////////////////////////////////////////////////////////////// */
+/**
+ * returns msg_size for tests that still pass int counts, capped at
+ * SMGC_INT_MSG_MAX. the large-count aware tests use msg_size as is.
+ */
+static int
+int_msg_size(void)
+{
+    return (msg_size > SMGC_INT_MSG_MAX) ? SMGC_INT_MSG_MAX : (int)msg_size;
+}
+
+/* ////////////////////////////////////////////////////////////////////////// */
+/**
+ * returns how many len B messages an exchange window holds: a2a_window, but
+ * no more than SMGC_WINDOW_MAX_BYTES worth and never fewer than one.
+ */
+static int
+window_msgs(size_t len)
+{
+    size_t max = (len > 0) ? SMGC_WINDOW_MAX_BYTES / len : (size_t)a2a_window;
+
+    if (max < 1) max = 1;
+    return (max < (size_t)a2a_window) ? (int)max : a2a_window;
+}
+
+/* ////////////////////////////////////////////////////////////////////////// */
+/**
+ * describes len B as *count elements of *type: len MPI_CHARs if len fits an
+ * int count, otherwise one struct of SMGC_LC_CHUNK B chunks followed by the
+ * remainder. release *type with lc_type_free.
+ */
+static int
+lc_type(size_t len, MPI_Datatype *type, int *count)
+{
+    int blens[2] = {0, 0};
+    MPI_Aint disps[2] = {0, 0};
+    MPI_Datatype types[2] = {MPI_DATATYPE_NULL, MPI_CHAR};
+
+    *type = MPI_CHAR;
+    *count = 0;
+    if (len <= INT_MAX) {
+        *count = (int)len;
+        return SMGC_SUCCESS;
+    }
+
+    mpi_ret_code = MPI_Type_contiguous(SMGC_LC_CHUNK, MPI_CHAR, &types[0]);
+    SMGC_MPICHK(mpi_ret_code, err);
+    blens[0] = (int)(len / SMGC_LC_CHUNK);
+    blens[1] = (int)(len % SMGC_LC_CHUNK);
+    disps[1] = (MPI_Aint)(len - len % SMGC_LC_CHUNK);
+    mpi_ret_code = MPI_Type_create_struct(2, blens, disps, types, type);
+    MPI_Type_free(&types[0]);
+    SMGC_MPICHK(mpi_ret_code, err);
+    mpi_ret_code = MPI_Type_commit(type);
+    SMGC_MPICHK(mpi_ret_code, err);
+    *count = 1;
+    return SMGC_SUCCESS;
+err:
+    lc_type_free(type);
+    return SMGC_ERROR;
+}
+
+/* ////////////////////////////////////////////////////////////////////////// */
+static void
+lc_type_free(MPI_Datatype *type)
+{
+    if (MPI_CHAR != *type && MPI_DATATYPE_NULL != *type) {
+        MPI_Type_free(type);
+    }
+    *type = MPI_DATATYPE_NULL;
+}
+
+/* ////////////////////////////////////////////////////////////////////////// */
+/**
+ * sends len B to dst and receives len B from src with tag on comm. uses the
+ * mpi-4 large-count interface when it is there and lc_type otherwise. the
+ * same goes for lc_bcast, lc_isend and lc_irecv.
+ */
+static int
+lc_sendrecv(const void *sbuf, size_t len, int dst, void *rbuf, int src,
+            int tag, MPI_Comm comm)
+{
+#if MPI_VERSION >= 4
+    mpi_ret_code = MPI_Sendrecv_c(sbuf, (MPI_Count)len, MPI_CHAR, dst, tag,
+                                  rbuf, (MPI_Count)len, MPI_CHAR, src, tag,
+                                  comm, MPI_STATUS_IGNORE);
+    SMGC_MPICHK(mpi_ret_code, err);
+    return SMGC_SUCCESS;
+err:
+    return SMGC_ERROR;
+#else
+    int count = 0, rc = SMGC_ERROR;
+    MPI_Datatype type = MPI_DATATYPE_NULL;
+
+    if (SMGC_SUCCESS != lc_type(len, &type, &count)) {
+        return SMGC_ERROR;
+    }
+    mpi_ret_code = MPI_Sendrecv(sbuf, count, type, dst, tag, rbuf, count, type,
+                                src, tag, comm, MPI_STATUS_IGNORE);
+    SMGC_MPICHK(mpi_ret_code, out);
+    rc = SMGC_SUCCESS;
+out:
+    lc_type_free(&type);
+    return rc;
+#endif
+}
+
+/* ////////////////////////////////////////////////////////////////////////// */
+static int
+lc_bcast(void *buf, size_t len, int root, MPI_Comm comm)
+{
+#if MPI_VERSION >= 4
+    mpi_ret_code = MPI_Bcast_c(buf, (MPI_Count)len, MPI_CHAR, root, comm);
+    SMGC_MPICHK(mpi_ret_code, err);
+    return SMGC_SUCCESS;
+err:
+    return SMGC_ERROR;
+#else
+    int count = 0, rc = SMGC_ERROR;
+    MPI_Datatype type = MPI_DATATYPE_NULL;
+
+    if (SMGC_SUCCESS != lc_type(len, &type, &count)) {
+        return SMGC_ERROR;
+    }
+    mpi_ret_code = MPI_Bcast(buf, count, type, root, comm);
+    SMGC_MPICHK(mpi_ret_code, out);
+    rc = SMGC_SUCCESS;
+out:
+    lc_type_free(&type);
+    return rc;
+#endif
+}
+
+/* ////////////////////////////////////////////////////////////////////////// */
+static int
+lc_isend(const void *buf, size_t len, int dst, int tag, MPI_Comm comm,
+         MPI_Request *req)
+{
+#if MPI_VERSION >= 4
+    mpi_ret_code = MPI_Isend_c(buf, (MPI_Count)len, MPI_CHAR, dst, tag, comm,
+                               req);
+    SMGC_MPICHK(mpi_ret_code, err);
+    return SMGC_SUCCESS;
+err:
+    return SMGC_ERROR;
+#else
+    int count = 0, rc = SMGC_ERROR;
+    MPI_Datatype type = MPI_DATATYPE_NULL;
+
+    if (SMGC_SUCCESS != lc_type(len, &type, &count)) {
+        return SMGC_ERROR;
+    }
+    /* a datatype may be freed while operations that use it are pending */
+    mpi_ret_code = MPI_Isend(buf, count, type, dst, tag, comm, req);
+    SMGC_MPICHK(mpi_ret_code, out);
+    rc = SMGC_SUCCESS;
+out:
+    lc_type_free(&type);
+    return rc;
+#endif
+}
+
+/* ////////////////////////////////////////////////////////////////////////// */
+static int
+lc_irecv(void *buf, size_t len, int src, int tag, MPI_Comm comm,
+         MPI_Request *req)
+{
+#if MPI_VERSION >= 4
+    mpi_ret_code = MPI_Irecv_c(buf, (MPI_Count)len, MPI_CHAR, src, tag, comm,
+                               req);
+    SMGC_MPICHK(mpi_ret_code, err);
+    return SMGC_SUCCESS;
+err:
+    return SMGC_ERROR;
+#else
+    int count = 0, rc = SMGC_ERROR;
+    MPI_Datatype type = MPI_DATATYPE_NULL;
+
+    if (SMGC_SUCCESS != lc_type(len, &type, &count)) {
+        return SMGC_ERROR;
+    }
+    mpi_ret_code = MPI_Irecv(buf, count, type, src, tag, comm, req);
+    SMGC_MPICHK(mpi_ret_code, out);
+    rc = SMGC_SUCCESS;
+out:
+    lc_type_free(&type);
+    return rc;
+#endif
+}
+
 /* ////////////////////////////////////////////////////////////////////////// */
 /**
  * returns number of tests within test suite pointed to by test_suite_ptr
@@ -330,15 +573,220 @@ get_time_str(time_t *raw_time)
 }
 
 /* ////////////////////////////////////////////////////////////////////////// */
+/**
+ * exposes host_name_buff through an rma window, so a report can fetch the
+ * host names of just the ranks it mentions. collective over mpi_comm_world.
+ * host names are only cosmetic: if the window cannot be created (no usable
+ * osc component, say), remote host names are reported as rhn_unknown.
+ */
+static int
+rhn_init(void)
+{
+    int rc = SMGC_ERROR;
+    MPI_Errhandler eh = MPI_ERRHANDLER_NULL;
+
+    /* there is no one to look up - and some osc components refuse singletons */
+    if (num_ranks < 2) {
+        return SMGC_SUCCESS;
+    }
+    /* a failure here must not take the run down */
+    mpi_ret_code = MPI_Comm_get_errhandler(MPI_COMM_WORLD, &eh);
+    SMGC_MPICHK(mpi_ret_code, out);
+    mpi_ret_code = MPI_Comm_set_errhandler(MPI_COMM_WORLD, MPI_ERRORS_RETURN);
+    SMGC_MPICHK(mpi_ret_code, out);
+    mpi_ret_code = MPI_Win_create(host_name_buff, SMGC_HOST_NAME_MAX,
+                                  sizeof(char), MPI_INFO_NULL, MPI_COMM_WORLD,
+                                  &rhn_win);
+    if (MPI_SUCCESS != mpi_ret_code) {
+        rhn_win = MPI_WIN_NULL;
+        MPI_Error_string(mpi_ret_code, err_str, &err_str_len);
+        SMGC_MPF("   host name window not available (%s) - remote host names "
+                 "will show as %s\n", err_str, rhn_unknown);
+    }
+    mpi_ret_code = MPI_Comm_set_errhandler(MPI_COMM_WORLD, eh);
+    SMGC_MPICHK(mpi_ret_code, out);
+
+    rc = SMGC_SUCCESS;
+out:
+    if (MPI_ERRHANDLER_NULL != eh) MPI_Errhandler_free(&eh);
+    return rc;
+}
+
+/* ////////////////////////////////////////////////////////////////////////// */
+static void
+rhn_fini(void)
+{
+    int i = 0;
+    smgc_rhn_ent_t *ent = NULL, *next = NULL;
+
+    if (MPI_WIN_NULL != rhn_win) {
+        MPI_Win_free(&rhn_win);
+    }
+    for (i = 0; i < SMGC_RHN_CACHE_BUCKETS; ++i) {
+        for (ent = rhn_cache[i]; NULL != ent; ent = next) {
+            next = ent->next;
+            free(ent);
+        }
+        rhn_cache[i] = NULL;
+    }
+}
+
+/* ////////////////////////////////////////////////////////////////////////// */
+/**
+ * returns the host name of rank without communicating: from the host name
+ * table if hostname_exchange has run, from the cache of names fetched so far
+ * otherwise. NULL if the name is not known locally. safe to call from the
+ * watchdog thread while it holds wd_lock.
+ */
+static char *
+rhn_lookup(int rank)
+{
+    smgc_rhn_ent_t *ent = NULL;
+
+    if (rank == my_rank) {
+        return host_name_buff;
+    }
+    if (NULL != host_table.rank_node) {
+        return host_table.names +
+               host_table.name_offs[host_table.rank_node[rank]];
+    }
+    for (ent = rhn_cache[rank % SMGC_RHN_CACHE_BUCKETS]; NULL != ent;
+         ent = ent->next) {
+        if (rank == ent->rank) {
+            return ent->name;
+        }
+    }
+    return NULL;
+}
+
+/* ////////////////////////////////////////////////////////////////////////// */
+/**
+ * fetches rank's host name from its rma window and caches it. only one rank
+ * is touched, so reports cost a handful of gets instead of a full exchange.
+ */
+static char *
+rhn_fetch(int rank)
+{
+    smgc_rhn_ent_t *ent = NULL;
+    int bucket = rank % SMGC_RHN_CACHE_BUCKETS;
+
+    if (MPI_WIN_NULL == rhn_win) {
+        return NULL;
+    }
+    if (NULL == (ent = (smgc_rhn_ent_t *)malloc(sizeof(smgc_rhn_ent_t)))) {
+        return NULL;
+    }
+    ent->rank = rank;
+    if (MPI_SUCCESS != MPI_Win_lock(MPI_LOCK_SHARED, rank, 0, rhn_win)) {
+        free(ent);
+        return NULL;
+    }
+    if (MPI_SUCCESS != MPI_Get(ent->name, SMGC_HOST_NAME_MAX, MPI_CHAR, rank,
+                               0, SMGC_HOST_NAME_MAX, MPI_CHAR, rhn_win) ||
+        MPI_SUCCESS != MPI_Win_unlock(rank, rhn_win)) {
+        free(ent);
+        return NULL;
+    }
+    ent->name[SMGC_HOST_NAME_MAX - 1] = '\0';
+
+    /* the watchdog thread may be walking the cache */
+#ifdef HAVE_PTHREAD_H
+    pthread_mutex_lock(&wd_lock);
+#endif
+    ent->next = rhn_cache[bucket];
+    rhn_cache[bucket] = ent;
+#ifdef HAVE_PTHREAD_H
+    pthread_mutex_unlock(&wd_lock);
+#endif
+    return ent->name;
+}
+
+/* ////////////////////////////////////////////////////////////////////////// */
+/**
+ * returns the host name of rank, fetching it from rank if it is not known
+ * locally. must only be called from the main thread.
+ */
 static char *
 get_rhn(int rank)
 {
-    if (NULL != rhname_lut_ptr) {
-        return &(rhname_lut_ptr[rank * SMGC_HOST_NAME_MAX]);
+    char *name = NULL;
+
+    if (rank < 0 || rank >= num_ranks) {
+        return rhn_unknown;
     }
-    else {
+    if (NULL != (name = rhn_lookup(rank)) ||
+        NULL != (name = rhn_fetch(rank))) {
+        return name;
+    }
+    return rhn_unknown;
+}
+
+/* ////////////////////////////////////////////////////////////////////////// */
+/**
+ * like get_rhn, but never communicates - for use by the watchdog thread.
+ */
+static char *
+get_rhn_cached(int rank)
+{
+    char *name = NULL;
+
+    if (rank < 0 || rank >= num_ranks) {
         return rhn_unknown;
     }
+    return (NULL != (name = rhn_lookup(rank))) ? name : rhn_unknown;
+}
+
+/* ////////////////////////////////////////////////////////////////////////// */
+static char *
+thread_level_str(int level)
+{
+    switch (level) {
+        case MPI_THREAD_SINGLE:
+            return "single";
+        case MPI_THREAD_FUNNELED:
+            return "funneled";
+        case MPI_THREAD_SERIALIZED:
+            return "serialized";
+        case MPI_THREAD_MULTIPLE:
+            return "multiple";
+        default:
+            return rhn_unknown;
+    }
+}
+
+/* ////////////////////////////////////////////////////////////////////////// */
+/**
+ * the thread support level is requested before options are parsed, so look
+ * for -X|--threads ahead of getopt. only a valid thread count (see: case 'X'
+ * in main) asks for MPI_THREAD_MULTIPLE.
+ */
+static bool
+threads_requested(int argc, char **argv)
+{
+    int i = 0, n = 0;
+    const char *arg = NULL, *val = NULL;
+
+    for (i = 1; i < argc; ++i) {
+        arg = argv[i];
+        val = NULL;
+        if ('-' != arg[0]) {
+            continue;
+        }
+        if ('X' == arg[1]) {
+            val = ('\0' != arg[2]) ? arg + 2 : argv[i + 1];
+        }
+        else if (0 == strncmp(arg + (('-' == arg[1]) ? 2 : 1), "threads",
+                              strlen("threads"))) {
+            val = strchr(arg, '=');
+            val = (NULL != val) ? val + 1 : argv[i + 1];
+        }
+        else {
+            continue;
+        }
+        n = (NULL != val) ? atoi(val) : 0;
+        return (n > 0 && n <= SMGC_MAX_THREADS);
+    }
+    return false;
 }
 
 /* ////////////////////////////////////////////////////////////////////////// */
@@ -365,1008 +813,6213 @@ set_jb_params()
 }
 
 /* ////////////////////////////////////////////////////////////////////////// */
-static int
-io_stats(double_int_t in_dint, char *label, int unit_type)
+/**
+ * returns the number of buffer arena bytes needed by the hungriest test in
+ * the selected test suite - tests that are not run do not count.
+ */
+static size_t
+arena_req_size(void)
 {
-    char *unit = NULL;
-    double val = in_dint.val;
-    double sum = 0.0;
-    double_int_t max = {0.0, 0}, min = {0.0, 0};
-    int mpi_ret_code = MPI_ERR_OTHER;
+    int i = 0;
+    size_t req = 0, tmp = 0;
 
-    switch (unit_type) {
-        case IO_STATS_TIME_S:
-            unit = SMGC_TIME_S_UNIT_STR;
-            break;
-        case IO_STATS_MBS:
-            unit = SMGC_MBS_UNIT_STR;
-            break;
-        default:
-            SMGC_ERR_MSG("io_stats::unknow unit_type\n");
-            goto err;
-            /* never reached */
-            break;
+    for (i = 0; i < num_tests; ++i) {
+        tmp = test_arena_size(smgc_test_ptr[i].tfp);
+        if (tmp > req) req = tmp;
     }
+    return req;
+}
 
-    mpi_ret_code = MPI_Reduce(&in_dint, &max, 1, MPI_DOUBLE_INT, MPI_MAXLOC,
-                              SMGC_MASTER_RANK, MPI_COMM_WORLD);
-    SMGC_MPICHK(mpi_ret_code, err);
-
-    mpi_ret_code = MPI_Reduce(&in_dint, &min, 1, MPI_DOUBLE_INT, MPI_MINLOC,
-                              SMGC_MASTER_RANK, MPI_COMM_WORLD);
-    SMGC_MPICHK(mpi_ret_code, err);
-
-    mpi_ret_code = MPI_Reduce(&val, &sum, 1, MPI_DOUBLE, MPI_SUM,
-                              SMGC_MASTER_RANK, MPI_COMM_WORLD);
-    SMGC_MPICHK(mpi_ret_code, err);
+/* ////////////////////////////////////////////////////////////////////////// */
+/**
+ * returns the number of buffer arena bytes test tfp needs. keep this in sync
+ * with the tests' arena_get calls.
+ */
+static size_t
+test_arena_size(func_ptr tfp)
+{
+    long pg = sysconf(_SC_PAGESIZE);
+    size_t page = (pg > 0) ? (size_t)pg : 4096;
+    size_t msg = SMGC_ROUND_UP((size_t)msg_size, page);
+    size_t imsg = SMGC_ROUND_UP((size_t)int_msg_size(), page);
+
+    /* rings: a send buffer per direction and a receive buffer */
+    if (&alt_sendrecv_ring == tfp || &large_sendrecv_ring == tfp) {
+        return 3 * (do_sweep ? SMGC_ROUND_UP((size_t)sweep_max, page) : msg);
+    }
+    else if (&root_bcast == tfp) {
+        return msg;
+    }
+    /* a send buffer and one receive buffer per window slot */
+    else if (&large_all_to_all_ptp == tfp) {
+        return ((size_t)window_msgs(msg_size) + 1) * msg;
+    }
+    else if (&bisection_bw == tfp) {
+        return ((size_t)window_msgs(int_msg_size()) + 1) * imsg;
+    }
+    /* incast: the root posts a window of receives */
+    else if (&large_all_to_root_ptp == tfp) {
+        return (do_incast ? (size_t)window_msgs(int_msg_size()) : 1) * imsg;
+    }
+    else if (&rand_root_bcast == tfp || &bcast_root_map == tfp) {
+        return imsg;
+    }
+    else if (&coll_suite == tfp || &persistent_ring == tfp ||
+             &rma_bw == tfp) {
+        return 2 * imsg;
+    }
+    /* dt_bw: send and receive layouts and pack buffers */
+    else if (&dt_bw == tfp) {
+        return 4 * imsg;
+    }
+    /* overlap: a send and a receive buffer of rendezvous size */
+    else if (&overlap == tfp) {
+        return 2 * SMGC_ROUND_UP(overlap_p2p_size(), page);
+    }
+    else if (&small_all_to_all_ptp == tfp) {
+        return 2 * page;
+    }
+    else if (&msg_rate == tfp) {
+        return SMGC_ROUND_UP((size_t)SMGC_MRATE_MSG_SIZE, page) +
+               SMGC_ROUND_UP((size_t)SMGC_MRATE_WINDOW * SMGC_MRATE_MSG_SIZE,
+                             page);
+    }
+    else if (&shm_bw == tfp) {
+        return 2 * SMGC_ROUND_UP((size_t)SMGC_SHM_MAX_SIZE, page);
+    }
+    else if (&proto_thresholds == tfp) {
+        return 2 * SMGC_ROUND_UP((size_t)SMGC_PROTO_MAX_SIZE, page);
+    }
+    else if (&mpi_io == tfp || &n_to_n_io == tfp) {
+        return SMGC_ROUND_UP(file_size, page);
+    }
+    return 0;
+}
+
+/* ////////////////////////////////////////////////////////////////////////// */
+/**
+ * sets up the buffer arena. the arena is page aligned, optionally backed by
+ * huge pages, and pre-faulted by this rank so that its pages are placed on
+ * this rank's numa node (first touch) before any test times anything.
+ */
+static int
+arena_init(size_t size)
+{
+    long pg = sysconf(_SC_PAGESIZE);
+    char *base = NULL;
+
+    buff_arena.page_size = (pg > 0) ? (size_t)pg : 4096;
+    size = SMGC_ROUND_UP((0 == size) ? 1 : size, buff_arena.page_size);
+    buff_arena.huge = false;
+    buff_arena.mapped = false;
+
+#ifdef HAVE_SYS_MMAN_H
+    if (use_hugepages) {
+        size = SMGC_ROUND_UP(size, (size_t)SMGC_HUGE_PAGE_SIZE);
+#ifdef MAP_HUGETLB
+        /* try explicitly reserved huge pages first */
+        base = mmap(NULL, size, PROT_READ | PROT_WRITE,
+                    MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+        if (MAP_FAILED == base) {
+            base = NULL;
+        }
+        else {
+            buff_arena.huge = true;
+        }
+#endif
+    }
+    if (NULL == base) {
+        base = mmap(NULL, size, PROT_READ | PROT_WRITE,
+                    MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        if (MAP_FAILED == base) {
+            int err = errno;
+            SMGC_ERR_MSG("mmap of %lu B failed on %s: %d (%s)\n",
+                         (unsigned long)size, host_name_buff, err,
+                         strerror(err));
+            return SMGC_ERROR;
+        }
+#ifdef MADV_HUGEPAGE
+        /* ...else fall back to transparent huge pages */
+        if (use_hugepages) {
+            buff_arena.huge = (0 == madvise(base, size, MADV_HUGEPAGE));
+        }
+#endif
+    }
+    buff_arena.mapped = true;
+#else
+    if (0 != posix_memalign((void **)&base, buff_arena.page_size, size)) {
+        SMGC_ERR_MSG("out of resources\n");
+        return SMGC_ERROR;
+    }
+#endif
+    /* pre-fault - the first touch happens here, not in a timed region */
+    memset(base, 0, size);
+
+    buff_arena.base = base;
+    buff_arena.size = size;
+    buff_arena.used = 0;
+
+    return SMGC_SUCCESS;
+}
+
+/* ////////////////////////////////////////////////////////////////////////// */
+/**
+ * borrows a page-aligned slice of at least len bytes from the buffer arena.
+ * slices are valid until the next arena_reset and are never freed by callers.
+ * returns NULL if the arena is exhausted.
+ */
+static void *
+arena_get(size_t len)
+{
+    char *ptr = NULL;
+    size_t slice = SMGC_ROUND_UP((0 == len) ? 1 : len, buff_arena.page_size);
+
+    if (NULL == buff_arena.base || slice > buff_arena.size - buff_arena.used) {
+        SMGC_ERR_MSG("buffer arena exhausted: requested %lu B, %lu B free\n",
+                     (unsigned long)slice,
+                     (unsigned long)(buff_arena.size - buff_arena.used));
+        return NULL;
+    }
+    ptr = buff_arena.base + buff_arena.used;
+    buff_arena.used += slice;
+
+    return ptr;
+}
+
+/* ////////////////////////////////////////////////////////////////////////// */
+/**
+ * returns all slices to the buffer arena. called between tests.
+ */
+static void
+arena_reset(void)
+{
+    buff_arena.used = 0;
+}
+
+/* ////////////////////////////////////////////////////////////////////////// */
+static void
+arena_fini(void)
+{
+    if (NULL == buff_arena.base) {
+        return;
+    }
+#ifdef HAVE_SYS_MMAN_H
+    if (buff_arena.mapped) {
+        munmap(buff_arena.base, buff_arena.size);
+    }
+    else {
+        free(buff_arena.base);
+    }
+#else
+    free(buff_arena.base);
+#endif
+    buff_arena.base = NULL;
+    buff_arena.size = 0;
+    buff_arena.used = 0;
+}
+
+/* ////////////////////////////////////////////////////////////////////////// */
+/**
+ * splitmix64 finalizer - cheap, well-mixed 64-bit hash.
+ */
+static uint64_t
+mix64(uint64_t z)
+{
+    z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+    return z ^ (z >> 31);
+}
+
+/* ////////////////////////////////////////////////////////////////////////// */
+/**
+ * splitmix64 generator. every rank that starts from the same state draws the
+ * same sequence, so randomized tests can agree on a schedule without
+ * communicating.
+ */
+static uint64_t
+seeded_rand(uint64_t *state)
+{
+    *state += 0x9e3779b97f4a7c15ULL;
+    return mix64(*state);
+}
+
+/* ////////////////////////////////////////////////////////////////////////// */
+/**
+ * returns the initial state of seeded stream stream of the current pass - the
+ * same on every rank.
+ */
+static uint64_t
+pass_seed(uint32_t stream)
+{
+    return mix64(rng_seed) ^
+           mix64(((uint64_t)(uint32_t)cur_pass << 32) | stream);
+}
+
+/* ////////////////////////////////////////////////////////////////////////// */
+/**
+ * fills perm with random perfect matching m (of the current pass) of n ranks:
+ * perm[2j] is paired with perm[2j + 1]. if n is odd, perm[n - 1] sits out.
+ */
+static void
+draw_matching(int *perm, int n, int m)
+{
+    int i = 0, j = 0, tmp = 0;
+    uint64_t state = pass_seed((uint32_t)m);
+
+    for (i = 0; i < n; ++i) {
+        perm[i] = i;
+    }
+    /* fisher-yates */
+    for (i = n - 1; i > 0; --i) {
+        j = (int)(seeded_rand(&state) % (uint64_t)(i + 1));
+        tmp = perm[i];
+        perm[i] = perm[j];
+        perm[j] = tmp;
+    }
+}
+
+/* ////////////////////////////////////////////////////////////////////////// */
+/**
+ * returns the rank paired with rank in matching perm (see draw_matching), -1
+ * if rank sits out.
+ */
+static int
+matching_partner(const int *perm, int n, int rank)
+{
+    int i = 0;
+
+    for (i = 0; i < n; ++i) {
+        if (rank == perm[i]) {
+            return ((i ^ 1) < n) ? perm[i ^ 1] : -1;
+        }
+    }
+    return -1;
+}
+
+/* ////////////////////////////////////////////////////////////////////////// */
+/**
+ * sets up all to all pairing schedule kind over n ranks. every step of a
+ * schedule is a permutation and every (src, dst) pair meets exactly once over
+ * steps 1 .. n. xor needs a power of two and transpose a square number of
+ * ranks - otherwise the schedule falls back to shift (see: sched->kind).
+ */
+static int
+sched_init(smgc_sched_t *sched, int kind, int n)
+{
+    int i = 0, j = 0, tmp = 0;
+    uint64_t state = 0;
+
+    sched->kind  = kind;
+    sched->n     = n;
+    sched->side  = 0;
+    sched->perm  = NULL;
+    sched->inv   = NULL;
+    sched->steps = NULL;
+
+    switch (kind) {
+        case SMGC_SCHED_XOR:
+            if (0 != (n & (n - 1))) {
+                sched->kind = SMGC_SCHED_SHIFT;
+            }
+            break;
+
+        case SMGC_SCHED_TRANSPOSE:
+            for (i = 1; i * i < n; ++i) {
+                ;
+            }
+            if (i * i == n) {
+                sched->side = i;
+            }
+            else {
+                sched->kind = SMGC_SCHED_SHIFT;
+            }
+            break;
+
+        case SMGC_SCHED_RANDOM:
+            sched->perm  = (int *)malloc(n * sizeof(int));
+            sched->inv   = (int *)malloc(n * sizeof(int));
+            sched->steps = (int *)malloc(n * sizeof(int));
+            if (NULL == sched->perm || NULL == sched->inv ||
+                NULL == sched->steps) {
+                SMGC_ERR_MSG("out of resources\n");
+                sched_fini(sched);
+                return SMGC_ERROR;
+            }
+            /* a random relabeling of the ranks ... */
+            draw_matching(sched->perm, n, SMGC_SEED_SCHED_PERM);
+            for (i = 0; i < n; ++i) {
+                sched->inv[sched->perm[i]] = i;
+            }
+            /* ... shifted by the steps 1 .. n in random order */
+            state = pass_seed(SMGC_SEED_SCHED_STEPS);
+            for (i = 0; i < n; ++i) {
+                sched->steps[i] = i + 1;
+            }
+            for (i = n - 1; i > 0; --i) {
+                j = (int)(seeded_rand(&state) % (uint64_t)(i + 1));
+                tmp = sched->steps[i];
+                sched->steps[i] = sched->steps[j];
+                sched->steps[j] = tmp;
+            }
+            break;
+
+        default:
+            break;
+    }
+    return SMGC_SUCCESS;
+}
+
+/* ////////////////////////////////////////////////////////////////////////// */
+static void
+sched_fini(smgc_sched_t *sched)
+{
+    if (NULL != sched->perm) free(sched->perm);
+    if (NULL != sched->inv) free(sched->inv);
+    if (NULL != sched->steps) free(sched->steps);
+    sched->perm  = NULL;
+    sched->inv   = NULL;
+    sched->steps = NULL;
+}
+
+/* ////////////////////////////////////////////////////////////////////////// */
+/**
+ * returns the rank that rank sends to (or receives from, if recv) at step
+ * (1 <= step <= n) of schedule sched:
+ * shift:     dst = rank + step
+ * xor:       dst = rank ^ step (butterfly)
+ * random:    shift over a seeded relabeling of the ranks, steps in seeded order
+ * transpose: dst = t(rank + step), where t swaps the row and column of a rank
+ *            in a square grid - step n is the transpose itself
+ * tornado:   dst = rank + step + (ceil(n / 2) - 1), so the first steps all
+ *            cross half of the ring at once
+ */
+static int
+sched_peer(const smgc_sched_t *sched, int rank, int step, bool recv)
+{
+    int n = sched->n;
+    int s = step % n;
+    int r = 0;
+
+    switch (sched->kind) {
+        case SMGC_SCHED_XOR:
+            return rank ^ s;
+
+        case SMGC_SCHED_RANDOM:
+            s = sched->steps[step - 1] % n;
+            r = sched->inv[rank];
+            return sched->perm[recv ? (r + n - s) % n : (r + s) % n];
+
+        case SMGC_SCHED_TRANSPOSE:
+            /* t is its own inverse */
+            if (recv) {
+                r = (rank % sched->side) * sched->side + rank / sched->side;
+                return (r + n - s) % n;
+            }
+            r = (rank + s) % n;
+            return (r % sched->side) * sched->side + r / sched->side;
+
+        case SMGC_SCHED_TORNADO:
+            s = (s + (n + 1) / 2 - 1) % n;
+            break;
+
+        default:
+            break;
+    }
+    return recv ? (rank + n - s) % n : (rank + s) % n;
+}
+
+/* ////////////////////////////////////////////////////////////////////////// */
+static void
+sched_print(const smgc_sched_t *sched)
+{
+    if (sched->kind == a2a_sched) {
+        SMGC_MPF("       schedule: %s\n", sched_names[sched->kind]);
+    }
+    else {
+        SMGC_MPF("       schedule: %s (%s needs a %s number of ranks)\n",
+                 sched_names[sched->kind], sched_names[a2a_sched],
+                 SMGC_SCHED_XOR == a2a_sched ? "power of two" : "square");
+    }
+}
+
+/* ////////////////////////////////////////////////////////////////////////// */
+/**
+ * returns the payload seed of a message sent from src to dst on iteration
+ * iter of the current pass. dst may be SMGC_PAYLOAD_ANY_RANK.
+ */
+static uint64_t
+payload_seed(int src, int dst, int iter)
+{
+    return mix64(((uint64_t)(uint32_t)src << 32) | (uint32_t)dst) ^
+           mix64(((uint64_t)(uint32_t)cur_pass << 32) | (uint32_t)iter);
+}
+
+/* ////////////////////////////////////////////////////////////////////////// */
+/**
+ * payloads are made of 4 KB blocks. word k of block b is pat[k] ^ key(b),
+ * where pat is derived from the seed once per message and key(b) once per
+ * block. so, every word depends on (seed, offset), but the per-word work is a
+ * load and an xor, which compilers turn into simd code. fills pat with the
+ * first n pattern words of seed.
+ */
+static void
+payload_pattern(uint64_t seed, uint64_t *pat, size_t n)
+{
+    size_t k;
+
+    for (k = 0; k < n; ++k) {
+        pat[k] = mix64(seed ^ ((k + 1) * 0x9e3779b97f4a7c15ULL));
+    }
+}
+
+/* ////////////////////////////////////////////////////////////////////////// */
+static void
+payload_fill(void *buff, size_t len, uint64_t seed)
+{
+    uint64_t pat[SMGC_PAYLOAD_BLK_WORDS], key = 0, word = 0;
+    unsigned char *ptr = (unsigned char *)buff;
+    size_t nwords = len / sizeof(uint64_t), b = 0, k = 0, n = 0;
+
+    n = (nwords + 1 < SMGC_PAYLOAD_BLK_WORDS) ? nwords + 1 :
+                                                SMGC_PAYLOAD_BLK_WORDS;
+    payload_pattern(seed, pat, n);
+
+    for (b = 0; nwords - k >= SMGC_PAYLOAD_BLK_WORDS; ++b) {
+        uint64_t blk[SMGC_PAYLOAD_BLK_WORDS];
+        size_t i;
+        key = mix64(seed + b);
+        for (i = 0; i < SMGC_PAYLOAD_BLK_WORDS; ++i) {
+            blk[i] = pat[i] ^ key;
+        }
+        memcpy(ptr, blk, sizeof(blk));
+        ptr += sizeof(blk);
+        k += SMGC_PAYLOAD_BLK_WORDS;
+    }
+    /* partial block - including any trailing bytes */
+    key = mix64(seed + b);
+    for (n = 0; k < nwords; ++k, ++n, ptr += sizeof(uint64_t)) {
+        word = pat[n] ^ key;
+        memcpy(ptr, &word, sizeof(uint64_t));
+    }
+    if (0 != len % sizeof(uint64_t)) {
+        word = pat[n] ^ key;
+        memcpy(ptr, &word, len % sizeof(uint64_t));
+    }
+}
+
+/* ////////////////////////////////////////////////////////////////////////// */
+/**
+ * regenerates the payload of seed and compares it against buff. on mismatch,
+ * returns SMGC_ERROR and sets *bad_off to the offset of the first bad byte.
+ */
+static int
+payload_check(const void *buff, size_t len, uint64_t seed, size_t *bad_off)
+{
+    uint64_t pat[SMGC_PAYLOAD_BLK_WORDS], key = 0, word = 0, diff = 0;
+    const unsigned char *ptr = (const unsigned char *)buff;
+    size_t nwords = len / sizeof(uint64_t), b = 0, k = 0, n = 0, i = 0;
+    size_t tail = len % sizeof(uint64_t);
+
+    n = (nwords + 1 < SMGC_PAYLOAD_BLK_WORDS) ? nwords + 1 :
+                                                SMGC_PAYLOAD_BLK_WORDS;
+    payload_pattern(seed, pat, n);
+
+    /* fast path: or-reduce the differences of a whole block */
+    for (b = 0; nwords - k >= SMGC_PAYLOAD_BLK_WORDS; ++b) {
+        uint64_t blk[SMGC_PAYLOAD_BLK_WORDS];
+        key = mix64(seed + b);
+        memcpy(blk, ptr, sizeof(blk));
+        for (i = 0, diff = 0; i < SMGC_PAYLOAD_BLK_WORDS; ++i) {
+            diff |= blk[i] ^ pat[i] ^ key;
+        }
+        if (0 != diff) {
+            break;
+        }
+        ptr += sizeof(blk);
+        k += SMGC_PAYLOAD_BLK_WORDS;
+    }
+    /* partial block, or the block containing the first mismatch */
+    key = mix64(seed + b);
+    for (n = 0; k < nwords; ++k, ++n, ptr += sizeof(uint64_t)) {
+        if (SMGC_PAYLOAD_BLK_WORDS == n) {
+            /* only reached when hunting a mismatch - it is in this block */
+            break;
+        }
+        memcpy(&word, ptr, sizeof(uint64_t));
+        if (0 != (diff = word ^ pat[n] ^ key)) {
+            goto mismatch;
+        }
+    }
+    if (k == nwords && 0 != tail) {
+        word = pat[n] ^ key;
+        for (i = 0; i < tail; ++i) {
+            if (ptr[i] != ((unsigned char *)&word)[i]) {
+                *bad_off = (size_t)(ptr - (const unsigned char *)buff) + i;
+                return SMGC_ERROR;
+            }
+        }
+    }
+    return SMGC_SUCCESS;
+
+mismatch:
+    /* find the first bad byte within the bad word */
+    word = pat[n] ^ key;
+    for (i = 0; i < sizeof(uint64_t); ++i) {
+        if (ptr[i] != ((unsigned char *)&word)[i]) {
+            break;
+        }
+    }
+    *bad_off = (size_t)(ptr - (const unsigned char *)buff) + i;
+    return SMGC_ERROR;
+}
+
+/* ////////////////////////////////////////////////////////////////////////// */
+/**
+ * fills buff with the payload of a message sent from src to dst on iteration
+ * iter (when payload verification is enabled).
+ */
+static void
+payload_prep(void *buff, size_t len, int src, int dst, int iter)
+{
+    if (do_verify) {
+        payload_fill(buff, len, payload_seed(src, dst, iter));
+    }
+}
+
+/* ////////////////////////////////////////////////////////////////////////// */
+/**
+ * verifies that buff holds the payload of a message sent from src to dst on
+ * iteration iter. time spent here is accumulated in verify_time so that
+ * callers can keep it out of their bandwidth numbers.
+ */
+static int
+payload_verify(const void *buff, size_t len, int src, int dst, int iter)
+{
+    int rc = SMGC_SUCCESS;
+    size_t bad_off = 0;
+    double start = 0.0;
+
+    if (!do_verify) {
+        return SMGC_SUCCESS;
+    }
+
+    start = MPI_Wtime();
+    rc = payload_check(buff, len, payload_seed(src, dst, iter), &bad_off);
+    verify_time += MPI_Wtime() - start;
+
+    if (SMGC_SUCCESS != rc) {
+        SMGC_ERR_MSG("payload corruption detected on rank %d (%s): message "
+                     "from rank %d (%s), iteration %d, %lu B, first bad byte "
+                     "at offset %lu\n", my_rank, host_name_buff, src,
+                     get_rhn(src), iter, (unsigned long)len,
+                     (unsigned long)bad_off);
+    }
+    return rc;
+}
+
+/* ////////////////////////////////////////////////////////////////////////// */
+/**
+ * reports (over comm) and resets the time spent verifying payloads in the
+ * current test.
+ */
+static int
+payload_verify_stats(MPI_Comm comm)
+{
+    double_int_t in_vt = {verify_time * 1e6, my_rank};
+
+    verify_time = 0.0;
+    if (!do_verify) {
+        return SMGC_SUCCESS;
+    }
+    return comm_stats(comm, in_vt, "payload verification time",
+                      IO_STATS_TIME_US);
+}
+
+/* ////////////////////////////////////////////////////////////////////////// */
+static int
+io_stats(double_int_t in_dint, char *label, int unit_type)
+{
+    return comm_stats(MPI_COMM_WORLD, in_dint, label, unit_type);
+}
+
+/* ////////////////////////////////////////////////////////////////////////// */
+/**
+ * reduces in_dint over comm to its rank 0 and prints the result. in_dint.rank
+ * must be an mpi_comm_world rank. comm's rank 0 is expected to be the master
+ * rank, so the master does the printing.
+ */
+static int
+comm_stats(MPI_Comm comm, double_int_t in_dint, char *label, int unit_type)
+{
+    char *unit = NULL;
+    double val = in_dint.val;
+    double sum = 0.0;
+    double_int_t max = {0.0, 0}, min = {0.0, 0};
+    int mpi_ret_code = MPI_ERR_OTHER, comm_size = 0;
+
+    switch (unit_type) {
+        case IO_STATS_TIME_S:
+            unit = SMGC_TIME_S_UNIT_STR;
+            break;
+        case IO_STATS_TIME_US:
+            unit = SMGC_TIME_US_UNIT_STR;
+            break;
+        case IO_STATS_MBS:
+            unit = SMGC_MBS_UNIT_STR;
+            break;
+        case IO_STATS_PCT:
+            unit = SMGC_PCT_UNIT_STR;
+            break;
+        case IO_STATS_MOPS:
+            unit = SMGC_MOPS_UNIT_STR;
+            break;
+        default:
+            SMGC_ERR_MSG("comm_stats::unknow unit_type\n");
+            goto err;
+            /* never reached */
+            break;
+    }
+
+    mpi_ret_code = MPI_Comm_size(comm, &comm_size);
+    SMGC_MPICHK(mpi_ret_code, err);
+
+    mpi_ret_code = MPI_Reduce(&in_dint, &max, 1, MPI_DOUBLE_INT, MPI_MAXLOC,
+                              SMGC_MASTER_RANK, comm);
+    SMGC_MPICHK(mpi_ret_code, err);
+
+    mpi_ret_code = MPI_Reduce(&in_dint, &min, 1, MPI_DOUBLE_INT, MPI_MINLOC,
+                              SMGC_MASTER_RANK, comm);
+    SMGC_MPICHK(mpi_ret_code, err);
+
+    mpi_ret_code = MPI_Reduce(&val, &sum, 1, MPI_DOUBLE, MPI_SUM,
+                              SMGC_MASTER_RANK, comm);
+    SMGC_MPICHK(mpi_ret_code, err);
+
+    SMGC_MPF("   --- %s:\n", label);
+    SMGC_MPF("          max rank: %06d (%s)\n", max.rank, get_rhn(max.rank));
+    SMGC_MPF("          max %s: %.3f %s\n", label, max.val, unit);
+    SMGC_MPF("          min rank: %06d (%s)\n", min.rank, get_rhn(min.rank));
+    SMGC_MPF("          min %s: %.3f %s\n", label, min.val, unit);
+    SMGC_MPF("          ave %s: %.3f %s\n", label, sum / comm_size, unit);
+    /* an aggregate only makes sense for rates */
+    if (IO_STATS_MBS == unit_type || IO_STATS_MOPS == unit_type) {
+        SMGC_MPF("          aggregate %s: %.3f %s\n", label, sum, unit);
+    }
+
+    return SMGC_SUCCESS;
+err:
+    return SMGC_ERROR;
+}
+
+/* ////////////////////////////////////////////////////////////////////////// */
+static int
+qsort_cmp_dbl(const void *p1,
+              const void *p2)
+{
+    double d1 = *(const double *)p1, d2 = *(const double *)p2;
+
+    return (d1 > d2) - (d1 < d2);
+}
+
+/* ////////////////////////////////////////////////////////////////////////// */
+/* largest value first */
+static int
+qsort_cmp_dint_desc(const void *p1,
+                    const void *p2)
+{
+    double d1 = ((const double_int_t *)p1)->val,
+           d2 = ((const double_int_t *)p2)->val;
+
+    return (d1 < d2) - (d1 > d2);
+}
+
+/* ////////////////////////////////////////////////////////////////////////// */
+/**
+ * total order on links: slower first, ties broken by (src, dst). keeping the
+ * order total makes top_links_merge commutative.
+ */
+static bool
+link_is_slower(const link_lat_t *a, const link_lat_t *b)
+{
+    if (a->lat != b->lat) return a->lat > b->lat;
+    if (a->src != b->src) return a->src < b->src;
+    return a->dst < b->dst;
+}
+
+/* ////////////////////////////////////////////////////////////////////////// */
+/**
+ * inserts (lat, src, dst) into top, a k-element list sorted slowest first, if
+ * it is slower than the current k-th slowest entry. empty entries have a
+ * negative latency.
+ */
+static void
+top_links_insert(link_lat_t *top, int k, double lat, int src, int dst)
+{
+    int i = k - 1;
+    link_lat_t new_link = {lat, src, dst};
+
+    /* common case: not one of the k slowest */
+    if (!link_is_slower(&new_link, &top[k - 1])) {
+        return;
+    }
+    for (; i > 0 && link_is_slower(&new_link, &top[i - 1]); --i) {
+        top[i] = top[i - 1];
+    }
+    top[i] = new_link;
+}
+
+/* ////////////////////////////////////////////////////////////////////////// */
+/**
+ * MPI_Op that merges two sorted lists of the k slowest links. each element of
+ * the datatype is an entire k-element list.
+ */
+static void
+top_links_merge(void *in, void *inout, int *len, MPI_Datatype *dtype)
+{
+    int i = 0, j = 0, a = 0, b = 0, type_size = 0, k = 0;
+    link_lat_t *in_ptr = (link_lat_t *)in, *io_ptr = (link_lat_t *)inout;
+    link_lat_t merged[SMGC_MAX_TOP_K_LINKS];
+
+    MPI_Type_size(*dtype, &type_size);
+    k = type_size / (int)sizeof(link_lat_t);
+
+    for (i = 0; i < *len; ++i, in_ptr += k, io_ptr += k) {
+        for (j = 0, a = 0, b = 0; j < k; ++j) {
+            if (link_is_slower(&in_ptr[a], &io_ptr[b])) {
+                merged[j] = in_ptr[a++];
+            }
+            else {
+                merged[j] = io_ptr[b++];
+            }
+        }
+        memcpy(io_ptr, merged, k * sizeof(link_lat_t));
+    }
+}
+
+/* ////////////////////////////////////////////////////////////////////////// */
+/**
+ * reduces every rank's k slowest links over comm to a top k at the master rank
+ * and prints them. cost is O(k) per rank regardless of job size.
+ */
+static int
+top_links_report(MPI_Comm comm, link_lat_t *my_top, int k)
+{
+    int i = 0, rc = SMGC_ERROR;
+    link_lat_t *top = NULL;
+    MPI_Datatype top_type = MPI_DATATYPE_NULL;
+    MPI_Op top_op = MPI_OP_NULL;
+
+    top = (link_lat_t *)malloc(k * sizeof(link_lat_t));
+    SMGC_MEMCHK(top, out);
+
+    mpi_ret_code = MPI_Type_contiguous(k * (int)sizeof(link_lat_t), MPI_BYTE,
+                                       &top_type);
+    SMGC_MPICHK(mpi_ret_code, out);
+    mpi_ret_code = MPI_Type_commit(&top_type);
+    SMGC_MPICHK(mpi_ret_code, out);
+    mpi_ret_code = MPI_Op_create(&top_links_merge, 1, &top_op);
+    SMGC_MPICHK(mpi_ret_code, out);
+
+    mpi_ret_code = MPI_Reduce(my_top, top, 1, top_type, top_op,
+                              SMGC_MASTER_RANK, comm);
+    SMGC_MPICHK(mpi_ret_code, out);
+
+    SMGC_MPF("   --- %d slowest links:\n", k);
+    for (i = 0; i < k && SMGC_MASTER_RANK == my_rank; ++i) {
+        if (top[i].src < 0) {
+            break;
+        }
+        SMGC_MPF("          %06d (%s) ==> %06d (%s): %.3f %s\n", top[i].src,
+                 get_rhn(top[i].src), top[i].dst, get_rhn(top[i].dst),
+                 top[i].lat * 1e6, SMGC_TIME_US_UNIT_STR);
+    }
+
+    rc = SMGC_SUCCESS;
+out:
+    if (MPI_OP_NULL != top_op) MPI_Op_free(&top_op);
+    if (MPI_DATATYPE_NULL != top_type) MPI_Type_free(&top_type);
+    if (NULL != top) free(top);
+    return rc;
+}
+
+/* ////////////////////////////////////////////////////////////////////////// */
+/**
+ * builds the tiers network tests can be run over: all ranks, the ranks that
+ * share my node (intra-node) and one leader rank per node (inter-node). called
+ * once - the tiers live until tiers_fini.
+ */
+static int
+tiers_init(void)
+{
+    int i = 0, t = 0, node_rank = 0, node_size = 0, is_leader = 0;
+    int *tier_ranks = NULL, rc = SMGC_ERROR;
+    MPI_Comm node_comm = MPI_COMM_NULL, leader_comm = MPI_COMM_NULL;
+    MPI_Group world_group = MPI_GROUP_NULL, tier_group = MPI_GROUP_NULL;
+
+    /* keying on my_rank keeps mpi_comm_world order within every tier, so the
+     * master rank is always rank 0 of its node and of the node leaders.
+     */
+    mpi_ret_code = MPI_Comm_split_type(MPI_COMM_WORLD, MPI_COMM_TYPE_SHARED,
+                                       my_rank, MPI_INFO_NULL, &node_comm);
+    SMGC_MPICHK(mpi_ret_code, out);
+    mpi_ret_code = MPI_Comm_rank(node_comm, &node_rank);
+    SMGC_MPICHK(mpi_ret_code, out);
+    mpi_ret_code = MPI_Comm_size(node_comm, &node_size);
+    SMGC_MPICHK(mpi_ret_code, out);
+
+    is_leader = (0 == node_rank);
+    mpi_ret_code = MPI_Comm_split(MPI_COMM_WORLD,
+                                  is_leader ? 0 : MPI_UNDEFINED, my_rank,
+                                  &leader_comm);
+    SMGC_MPICHK(mpi_ret_code, out);
+
+    mpi_ret_code = MPI_Allreduce(&is_leader, &num_nodes, 1, MPI_INT, MPI_SUM,
+                                 MPI_COMM_WORLD);
+    SMGC_MPICHK(mpi_ret_code, out);
+    mpi_ret_code = MPI_Allreduce(&node_size, &max_node_ranks, 1, MPI_INT,
+                                 MPI_MAX, MPI_COMM_WORLD);
+    SMGC_MPICHK(mpi_ret_code, out);
+
+    tiers[0].name = "mpi_comm_world";
+    tiers[0].desc = "all ranks";
+    tiers[0].comm = MPI_COMM_WORLD;
+    tiers[0].stats_comm = MPI_COMM_WORLD;
+    /* every node's instance of the intra-node tier runs at the same time, so
+     * its results are reduced over everyone.
+     */
+    tiers[1].name = "node_comm";
+    tiers[1].desc = "ranks sharing a node (intra-node)";
+    tiers[1].comm = node_comm;
+    tiers[1].stats_comm = MPI_COMM_WORLD;
+    tiers[2].name = "node_leader_comm";
+    tiers[2].desc = "one rank per node (inter-node)";
+    tiers[2].comm = leader_comm;
+    tiers[2].stats_comm = leader_comm;
+    node_comm = leader_comm = MPI_COMM_NULL;
+
+    mpi_ret_code = MPI_Comm_group(MPI_COMM_WORLD, &world_group);
+    SMGC_MPICHK(mpi_ret_code, out);
+
+    for (t = 0; t < SMGC_NUM_TIERS; ++t) {
+        /* with a single node or a single rank per node, the node tiers are
+         * just mpi_comm_world (or singletons) all over again.
+         */
+        tiers[t].useful = (0 == t) || (num_nodes > 1 && max_node_ranks > 1);
+        tiers[t].rank = -1;
+        tiers[t].size = 0;
+        tiers[t].world_ranks = NULL;
+        if (MPI_COMM_NULL == tiers[t].comm) {
+            continue;
+        }
+        mpi_ret_code = MPI_Comm_rank(tiers[t].comm, &tiers[t].rank);
+        SMGC_MPICHK(mpi_ret_code, out);
+        mpi_ret_code = MPI_Comm_size(tiers[t].comm, &tiers[t].size);
+        SMGC_MPICHK(mpi_ret_code, out);
+
+        tiers[t].world_ranks = (int *)malloc(tiers[t].size * sizeof(int));
+        SMGC_MEMCHK(tiers[t].world_ranks, out);
+        tier_ranks = (int *)malloc(tiers[t].size * sizeof(int));
+        SMGC_MEMCHK(tier_ranks, out);
+        for (i = 0; i < tiers[t].size; ++i) {
+            tier_ranks[i] = i;
+        }
+        mpi_ret_code = MPI_Comm_group(tiers[t].comm, &tier_group);
+        SMGC_MPICHK(mpi_ret_code, out);
+        mpi_ret_code = MPI_Group_translate_ranks(tier_group, tiers[t].size,
+                                                 tier_ranks, world_group,
+                                                 tiers[t].world_ranks);
+        SMGC_MPICHK(mpi_ret_code, out);
+        MPI_Group_free(&tier_group);
+        free(tier_ranks);
+        tier_ranks = NULL;
+    }
+
+    rc = SMGC_SUCCESS;
+out:
+    if (MPI_GROUP_NULL != tier_group) MPI_Group_free(&tier_group);
+    if (MPI_GROUP_NULL != world_group) MPI_Group_free(&world_group);
+    if (MPI_COMM_NULL != node_comm) MPI_Comm_free(&node_comm);
+    if (MPI_COMM_NULL != leader_comm) MPI_Comm_free(&leader_comm);
+    if (NULL != tier_ranks) free(tier_ranks);
+    return rc;
+}
+
+/* ////////////////////////////////////////////////////////////////////////// */
+static void
+tiers_fini(void)
+{
+    int t = 0;
+
+    for (t = 0; t < SMGC_NUM_TIERS; ++t) {
+        if (MPI_COMM_NULL != tiers[t].comm &&
+            MPI_COMM_WORLD != tiers[t].comm) {
+            MPI_Comm_free(&tiers[t].comm);
+        }
+        tiers[t].comm = MPI_COMM_NULL;
+        if (NULL != tiers[t].world_ranks) {
+            free(tiers[t].world_ranks);
+            tiers[t].world_ranks = NULL;
+        }
+    }
+}
+
+/* ////////////////////////////////////////////////////////////////////////// */
+/**
+ * returns the mpi_comm_world rank of tier rank r. negative ranks (any/all)
+ * are passed through.
+ */
+static int
+tier_wrank(const smgc_tier_t *tier, int r)
+{
+    return (r < 0) ? r : tier->world_ranks[r];
+}
+
+/* ////////////////////////////////////////////////////////////////////////// */
+/**
+ * runs tfp over mpi_comm_world and, in node-aware mode, over the intra-node
+ * and node leader tiers so shared memory and network results are reported
+ * separately. ranks outside of a tier wait for it to finish.
+ */
+static int
+run_on_tiers(tier_func_ptr tfp)
+{
+    int t = 0;
+
+    for (t = 0; t < SMGC_NUM_TIERS; ++t) {
+        if (0 != t && (!node_aware || !tiers[t].useful)) {
+            continue;
+        }
+        if (node_aware) {
+            SMGC_MPF("   --- tier %s: %s\n", tiers[t].name, tiers[t].desc);
+        }
+        /* each tier gets the whole buffer arena */
+        arena_reset();
+        if (MPI_COMM_NULL != tiers[t].comm && SMGC_SUCCESS != tfp(&tiers[t])) {
+            return SMGC_ERROR;
+        }
+        mpi_ret_code = MPI_Barrier(MPI_COMM_WORLD);
+        SMGC_MPICHK(mpi_ret_code, err);
+    }
+    return SMGC_SUCCESS;
+err:
+    return SMGC_ERROR;
+}
+
+/* ////////////////////////////////////////////////////////////////////////// */
+/* ////////////////////////////////////////////////////////////////////////// */
+/* test functions                                                             */
+/* ////////////////////////////////////////////////////////////////////////// */
+/* ////////////////////////////////////////////////////////////////////////// */
+
+/* ////////////////////////////////////////////////////////////////////////// */
+/* test by request only */
+static int
+n_to_n_io(void)
+{
+    int i = 0, fd = -1, rc = SMGC_ERROR, mpi_rc = MPI_ERR_OTHER;
+    /* what we are going to write and what we should read, buff rest char */
+    char wr_char = 'j', clobber_char = 'x';
+    ssize_t j = 0, bytes_written = -1, bytes_read = -1, nio = 0;
+    /* the size of the file that i'll be writing (in B) */
+    size_t buff_size = file_size;
+    char *my_file_name = NULL;
+    /* points to buffer used for both reading and writing */
+    char *buff = NULL;
+    /* variables for recording time */
+    double open_time = 0.0, close_time = 0.0, write_start = 0.0,
+           write_fin = 0.0;
+    double read_start = 0.0, read_fin = 0.0, lseek_start = 0.0, lseek_fin = 0.0,
+           effe_bw_time_fix = 0.0, memset_start = 0.0, memset_fin = 0.0,
+           tmp_dbl = 0.0;
+    /* bandwidth variables */
+    double effe_bw = 0.0, read_bw = 0.0, write_bw = 0.0;
+    /* for reduce operations that find max and min rank */
+    double_int_t in_effe = {0.0, 0};
+    double_int_t in_wr = {0.0, 0};
+    double_int_t in_rd = {0.0, 0};
+
+    /* no work to do, return success and move on */
+    if (0 == num_fs_test_paths) {
+        SMGC_MPF("       zero paths requested via -w option. skipping test.\n");
+        return SMGC_SUCCESS;
+    }
+
+    /* if we are here, let the games begin! */
+
+    if (NULL == (buff = (char *)arena_get(buff_size * sizeof(char)))) {
+        return SMGC_ERROR;
+    }
+    memset(buff, wr_char, buff_size);
+
+    SMGC_MPF("       file size (per rank process): %lu B\n", buff_size);
+
+    /* write to all requested paths */
+    for (i = 0; i < num_fs_test_paths; ++i) {
+        if (-1 == asprintf(&my_file_name, "%s/%s_%d", fs_test_list[i],
+                           SMGC_MPI_FILE_NAME, my_rank)) {
+            SMGC_ERR_MSG("out of resources\n");
+            goto out;
+        }
+        if (NULL == my_file_name) {
+            SMGC_ERR_MSG("out of resources\n");
+            goto out;
+        }
+
+        /* let the user know we are working on it */
+        SMGC_MPF("   === mpi_comm_world: writing to %s\n", fs_test_list[i]);
+
+        /* barrier before we start */
+        mpi_rc = MPI_Barrier(MPI_COMM_WORLD);
+        SMGC_MPICHK(mpi_rc, out);
+
+        open_time = MPI_Wtime();
+        if (-1 == (fd = open(my_file_name, O_CREAT | O_RDWR, 0600))) {
+            int error = errno;
+            SMGC_ERR_MSG("open failed with errno: %d (%s)\n", error,
+                         strerror(error));
+            goto out;
+        }
+
+        write_start = MPI_Wtime();
+        /* large files take more than one call (linux moves < 2 GB a call) */
+        for (bytes_written = 0; (size_t)bytes_written < buff_size;
+             bytes_written += nio) {
+            if (-1 == (nio = write(fd, buff + bytes_written,
+                                   buff_size - bytes_written))) {
+                int error = errno;
+                SMGC_ERR_MSG("write failed with errno: %d (%s)\n", error,
+                             strerror(error));
+                goto out;
+            }
+        }
+        write_fin = MPI_Wtime();
+
+        /* seek to beginning of file - time this step so we can subtract the
+         * time spent here from our bw calculations
+         */
+        lseek_start = MPI_Wtime();
+        if(-1 == lseek(fd, 0, SEEK_SET)) {
+            int error = errno;
+            SMGC_ERR_MSG("lseek failed with errno: %d (%s)\n", error,
+                         strerror(error));
+            goto out;
+        }
+        lseek_fin = MPI_Wtime();
+
+        memset_start = MPI_Wtime();
+        /* overwrite buff's contents before read */
+        memset(buff, clobber_char, buff_size);
+        memset_fin = MPI_Wtime();
+
+        read_start = MPI_Wtime();
+        for (bytes_read = 0; (size_t)bytes_read < buff_size;
+             bytes_read += nio) {
+            if (-1 == (nio = read(fd, buff + bytes_read,
+                                  buff_size - bytes_read))) {
+                int error = errno;
+                SMGC_ERR_MSG("read failed with errno: %d (%s)\n", error,
+                             strerror(error));
+                goto out;
+            }
+            /* eof */
+            if (0 == nio) {
+                break;
+            }
+        }
+        read_fin = MPI_Wtime();
+
+        if (0 != close(fd)) {
+            int error = errno;
+            SMGC_ERR_MSG("close failed with errno: %d (%s)\n", error,
+                         strerror(error));
+            goto out;
+        }
+        close_time = MPI_Wtime();
+
+        fd = -1;
+
+        if (0 != unlink(my_file_name)) {
+            int error = errno;
+            SMGC_ERR_MSG("unlink failed with errno: %d (%s)\n", error,
+                         strerror(error));
+            goto out;
+        }
+        /* check integrity of read */
+        if (bytes_written != bytes_read) {
+            SMGC_ERR_MSG("write/read mismatch.  wrote %lu read %lu\n",
+                         bytes_written, bytes_read);
+            goto out;
+        }
+        /* iterate over char buff - making certain all is well */
+        for (j = 0; j < bytes_written; ++j) {
+            if (wr_char != buff[j]) {
+                SMGC_ERR_MSG(
+                    "characters read do not match characters written!\n"
+                );
+                goto out;
+            }
+        }
+
+        /* subtract time not spent in benchmarked routines */
+        effe_bw_time_fix = (lseek_fin - lseek_start) +
+                           (memset_fin - memset_start);
+
+        /* calculate bandwidths */
+
+        /* negative and 0 length file size protection provided by lower level */
+        /* zero value fixup - good enough for our purposes */
+
+        /* effective bandwidth */
+        if (0.0 >= (tmp_dbl = ((close_time - open_time) - effe_bw_time_fix))) {
+            effe_bw = 0.0;
+        }
+        else {
+            effe_bw = ((double)buff_size / tmp_dbl / (double)SMGC_MB_SIZE);
+        }
+        /* write bandwidth */
+        if (0.0 >= (tmp_dbl = (write_fin - write_start))) {
+            write_bw = 0.0;
+        }
+        else {
+            write_bw = ((double)buff_size / tmp_dbl / (double)SMGC_MB_SIZE);
+        }
+        /* read bandwidth */
+        if (0.0 >= (tmp_dbl = (read_fin - read_start))) {
+            read_bw = 0.0;
+        }
+        else {
+            read_bw = ((double)buff_size / tmp_dbl / (double)SMGC_MB_SIZE);
+        }
+
+        /* prepare values for reduce */
+        in_effe.val = effe_bw;
+        in_effe.rank = my_rank;
+        in_wr.val = write_bw;
+        in_wr.rank = my_rank;
+        in_rd.val = read_bw;
+        in_rd.rank = my_rank;
+
+        /* calculate effective bandwidth stats */
+        if (SMGC_SUCCESS != (rc = io_stats(in_effe, "effective write bandwidth",
+                                           IO_STATS_MBS))) {
+            goto out;
+        }
+        /* calculate write bandwidth stats */
+        if (SMGC_SUCCESS != (rc = io_stats(in_wr, "pure write bandwidth",
+                                           IO_STATS_MBS))) {
+            goto out;
+        }
+        /* calculate read bandwidth stats */
+        if (SMGC_SUCCESS != (rc = io_stats(in_rd, "pure read bandwidth",
+                                           IO_STATS_MBS))) {
+            goto out;
+        }
+
+        /* all is well for this iteration */
+        if (NULL != my_file_name) {
+            free(my_file_name);
+            my_file_name = NULL;
+        }
+    }
+
+    /* all is well */
+    rc = SMGC_SUCCESS;
+out:
+    if (-1 != fd) {
+        close(fd);
+        unlink(my_file_name);
+    }
+    if (NULL != my_file_name) free(my_file_name);
+    return rc;
+}
+
+/* ////////////////////////////////////////////////////////////////////////// */
+static int
+hello_world(void)
+{
+    int res_len = 0;
+    char name_buff[MPI_MAX_PROCESSOR_NAME + 1];
+
+    mpi_ret_code = MPI_Get_processor_name(name_buff, &res_len);
+    SMGC_MPICHK(mpi_ret_code, err);
+
+    SMGC_FPF(stdout, "       hello from rank %06d (%s) of %06d\n", my_rank,
+             name_buff, num_ranks);
+
+    return SMGC_SUCCESS;
+err:
+    return SMGC_ERROR;
+}
+
+/* ////////////////////////////////////////////////////////////////////////// */
+static int
+stat_paths(void)
+{
+    int i = 0;
+    struct stat buff;
+    /* nothing to do, so that's easy */
+    if (0 == num_stat_paths) {
+        SMGC_MPF("       zero paths requested via -s option. skipping test.\n");
+        return SMGC_SUCCESS;
+    }
+
+    for (i = 0; i < num_stat_paths; ++i) {
+        SMGC_MPF("       mpi_comm_world: stating %s\n", stat_list[i]);
+        /* try to stat the file */
+        if (0 != stat(stat_list[i], &buff)) {
+            SMGC_FPF(stderr, "   !!! rank %d (%s) unable to stat %s\n", my_rank,
+                     host_name_buff, stat_list[i]);
+            return SMGC_ERROR;
+        }
+    }
+    return SMGC_SUCCESS;
+}
+
+/* ////////////////////////////////////////////////////////////////////////// */
+/**
+ * returns a host name for a watchdog report peer. the watchdog thread never
+ * makes mpi calls, so this only consults what is already known locally.
+ */
+static char *
+wd_peer_name(int rank)
+{
+    if (rank < 0) {
+        return "ANY";
+    }
+    return get_rhn_cached(rank);
+}
+
+#ifdef HAVE_PTHREAD_H
+/* ////////////////////////////////////////////////////////////////////////// */
+static double
+wd_now(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + (double)ts.tv_nsec * 1e-9;
+}
+
+/* ////////////////////////////////////////////////////////////////////////// */
+/**
+ * watchdog thread. every SMGC_WD_PERIOD_MS it looks at every active
+ * operation; one whose progress counter has not moved for longer than its
+ * timeout is hung. all hung operations are reported before the process exits.
+ */
+static void *
+wd_main(void *arg)
+{
+    int i = 0, num_hung = 0;
+    unsigned long seq = 0;
+    double now = 0.0;
+    struct timespec wake;
+    (void)arg;
+
+    pthread_mutex_lock(&wd_lock);
+    while (!wd_stop_req) {
+        clock_gettime(CLOCK_REALTIME, &wake);
+        wake.tv_nsec += SMGC_WD_PERIOD_MS * 1000000L;
+        wake.tv_sec += wake.tv_nsec / 1000000000L;
+        wake.tv_nsec %= 1000000000L;
+        pthread_cond_timedwait(&wd_cond, &wd_lock, &wake);
+        if (wd_stop_req) {
+            break;
+        }
+
+        now = wd_now();
+        for (i = 0, num_hung = 0; i < SMGC_WD_MAX_OPS; ++i) {
+            smgc_wd_op_t *op = &wd_ops[i];
+
+            if (NULL == op->tname ||
+                0 == (seq = SMGC_ATOMIC_LOAD(&op->seq))) {
+                continue;
+            }
+            if (seq != op->seen_seq) {
+                op->seen_seq = seq;
+                op->seen_time = now;
+                continue;
+            }
+            if (now - op->seen_time < (double)op->timeout) {
+                continue;
+            }
+            if (0 == num_hung++) {
+                fprintf(stderr, "\n");
+            }
+            fprintf(stderr, "########## HANG DETECTED [%s: step %d, no "
+                    "progress for %.0f s] %d (%s) ==> %d (%s) ==> %d (%s) "
+                    "##########\n", op->tname,
+                    SMGC_RELAXED_LOAD(&op->step), now - op->seen_time,
+                    SMGC_RELAXED_LOAD(&op->src),
+                    wd_peer_name(SMGC_RELAXED_LOAD(&op->src)), my_rank,
+                    host_name_buff, SMGC_RELAXED_LOAD(&op->dst),
+                    wd_peer_name(SMGC_RELAXED_LOAD(&op->dst)));
+        }
+        if (0 != num_hung) {
+            fflush(stderr);
+            /* give the other ranks' watchdogs a chance to report, too */
+            pthread_mutex_unlock(&wd_lock);
+            sleep(SMGC_WD_GRACE_S);
+            exit(EXIT_FAILURE);
+        }
+    }
+    pthread_mutex_unlock(&wd_lock);
+
+    return NULL;
+}
+#endif /* HAVE_PTHREAD_H */
+
+/* ////////////////////////////////////////////////////////////////////////// */
+/**
+ * starts the watchdog thread if a message timeout was requested.
+ */
+static int
+wd_start(void)
+{
+    if (msg_timeout <= 0 || wd_running) {
+        return SMGC_SUCCESS;
+    }
+#ifdef HAVE_PTHREAD_H
+    wd_stop_req = false;
+    if (0 != pthread_create(&wd_thread, NULL, &wd_main, NULL)) {
+        SMGC_ERR_MSG("unable to start the watchdog thread on %s\n",
+                     host_name_buff);
+        return SMGC_ERROR;
+    }
+    wd_running = true;
+#else
+    SMGC_MPF("   !!! built without pthreads: message timeouts are disabled\n");
+#endif
+    return SMGC_SUCCESS;
+}
+
+/* ////////////////////////////////////////////////////////////////////////// */
+static void
+wd_stop(void)
+{
+#ifdef HAVE_PTHREAD_H
+    if (!wd_running) {
+        return;
+    }
+    pthread_mutex_lock(&wd_lock);
+    wd_stop_req = true;
+    pthread_cond_signal(&wd_cond);
+    pthread_mutex_unlock(&wd_lock);
+    pthread_join(wd_thread, NULL);
+    wd_running = false;
+#endif
+}
+
+/* ////////////////////////////////////////////////////////////////////////// */
+/**
+ * registers an operation with the watchdog. timeout is in seconds; values
+ * <= 0 select the -T timeout. returns NULL when there is no watchdog (which
+ * the other wd_op_* functions accept), so callers need not care.
+ */
+static smgc_wd_op_t *
+wd_op_begin(const char *tname, int timeout)
+{
+    smgc_wd_op_t *op = NULL;
+#ifdef HAVE_PTHREAD_H
+    int i = 0;
+
+    if (!wd_running) {
+        return NULL;
+    }
+    pthread_mutex_lock(&wd_lock);
+    for (i = 0; i < SMGC_WD_MAX_OPS; ++i) {
+        if (NULL == wd_ops[i].tname) {
+            op = &wd_ops[i];
+            op->tname = tname;
+            op->timeout = (timeout > 0) ? timeout : msg_timeout;
+            op->step = op->src = op->dst = -1;
+            op->seen_seq = 0;
+            SMGC_ATOMIC_STORE(&op->seq, 0UL);
+            break;
+        }
+    }
+    pthread_mutex_unlock(&wd_lock);
+#else
+    (void)tname;
+    (void)timeout;
+#endif
+    return op;
+}
+
+/* ////////////////////////////////////////////////////////////////////////// */
+/**
+ * publishes progress: op is now working on step with the given peers (-1:
+ * any/all). this is called from hot loops, so it is a handful of plain
+ * stores - only the final one needs to be ordered.
+ */
+static void
+wd_op_step(smgc_wd_op_t *op, int step, int src, int dst)
+{
+    if (NULL == op) {
+        return;
+    }
+    SMGC_RELAXED_STORE(&op->step, step);
+    SMGC_RELAXED_STORE(&op->src, src);
+    SMGC_RELAXED_STORE(&op->dst, dst);
+    SMGC_ATOMIC_STORE(&op->seq, op->seq + 1);
+}
+
+/* ////////////////////////////////////////////////////////////////////////// */
+static void
+wd_op_end(smgc_wd_op_t *op)
+{
+#ifdef HAVE_PTHREAD_H
+    if (NULL == op) {
+        return;
+    }
+    pthread_mutex_lock(&wd_lock);
+    SMGC_ATOMIC_STORE(&op->seq, 0UL);
+    op->tname = NULL;
+    pthread_mutex_unlock(&wd_lock);
+#else
+    (void)op;
+#endif
+}
+
+/* ////////////////////////////////////////////////////////////////////////// */
+#if SMGC_HAVE_CELL_SUPPORT == 1
+
+/* in seconds */
+#define CELL_TEST_TIMEOUT 480
+
+/* ////////////////////////////////////////////////////////////////////////// */
+static void
+kill_cell_check(void)
+{
+    /* no check in error path  - hope for the best */
+    gethostname(host_name_buff, SMGC_HOST_NAME_MAX - 1);
+    host_name_buff[SMGC_HOST_NAME_MAX - 1] = '\0';
+
+    SMGC_ERR_MSG(
+        "rank %d (%s) unable to execute cell_sanity test within %d s.\n",
+         my_rank, host_name_buff, CELL_TEST_TIMEOUT);
+
+    exit(EXIT_FAILURE);
+}
+
+/* ////////////////////////////////////////////////////////////////////////// */
+static int
+cell_sanity(void)
+{
+    unsigned long rc = 0;
+    struct itimerval itimer;
+
+    itimer.it_value.tv_sec = CELL_TEST_TIMEOUT;
+    itimer.it_value.tv_usec = 0;
+    itimer.it_interval = itimer.it_value;
+
+    SMGC_MPF("       mpi_comm_world: running cell diagnostics\n");
+
+    signal(SIGALRM, (void(*)(int))&kill_cell_check);
+    setitimer(ITIMER_REAL, &itimer, NULL);
+
+    if (0 != (rc = cell_check(CELL_CHECK_MSG_FAIL, CELL_CHECK_TEST_ALL))) {
+        SMGC_ERR_MSG("cell_check failure - return code: %lu\n", rc);
+        goto err;
+    }
+    else {
+        /* all is well... disable the alarm */
+        itimer.it_value.tv_sec = 0;
+        itimer.it_value.tv_usec = 0;
+        itimer.it_interval = itimer.it_value;
+        setitimer(ITIMER_REAL, &itimer, NULL);
+    }
+
+    return SMGC_SUCCESS;
+err:
+    return SMGC_ERROR;
+}
+#endif /* SMGC_HAVE_CELL_SUPPORT */
+
+/* ////////////////////////////////////////////////////////////////////////// */
+static int
+mpi_io(void)
+{
+    int mpi_ret_code = MPI_ERR_OTHER, i = 0, rc = SMGC_ERROR, count = 0;
+    /* access mode flags */
+    int amode = MPI_MODE_RDWR | MPI_MODE_CREATE | MPI_MODE_DELETE_ON_CLOSE;
+    char *buff = NULL, path_buff[SMGC_PATH_MAX];
+    /* i/o time markers */
+    double effe_start = 0.0, effe_fin = 0.0;
+    double write_start = 0.0, write_fin = 0.0, read_start = 0.0, read_fin = 0.0;
+    /* bandwidth variables */
+    double effe_bw = 0.0, write_bw = 0.0, read_bw = 0.0, effe_bw_time_fix = 0.0,
+           gete_start = 0.0, gete_fin = 0.0, gete_start2 = 0.0, gete_fin2 = 0.0;
+    double tmp_dbl = 0.0;
+    /* structs for min/max */
+    double_int_t in_wr = {0.0, 0}, in_rd = {0.0, 0}, in_effe = {0.0, 0};
+    /* file handle */
+    MPI_File mpi_fh;
+    MPI_Status status;
+    MPI_Offset offset = (MPI_Offset)my_rank * (MPI_Offset)file_size;
+    MPI_Count num_elems = 0;
+    /* file_size B as count elements of type - see lc_type */
+    MPI_Datatype type = MPI_DATATYPE_NULL;
+
+    /* no writing to do, so return SMGC_SUCCESS */
+    if (0 == num_fs_test_paths) {
+        SMGC_MPF("       zero paths requested via -w option. skipping test.\n");
+        return SMGC_SUCCESS;
+    }
+
+    buff = (char *)arena_get(file_size * sizeof(char));
+    SMGC_MEMCHK(buff, out);
+
+    memset(buff, 'j', (size_t)(file_size * sizeof(char)));
+
+    if (SMGC_SUCCESS != lc_type(file_size, &type, &count)) {
+        goto out;
+    }
+
+    /* if we are here, then let the real work begin */
+
+    SMGC_MPF("       file size (per rank process): %lu B\n", file_size);
+
+    for (i = 0; i < num_fs_test_paths; ++i) {
+        int nw = snprintf(path_buff, SMGC_PATH_MAX, "%s/%s", fs_test_list[i],
+                          SMGC_MPI_FILE_NAME);
+        if (nw >= SMGC_PATH_MAX) return SMGC_ERROR;
+
+        SMGC_MPF("   === mpi_comm_world: writing to %s\n", fs_test_list[i]);
+
+        /* barrier before we start each iteration */
+        mpi_ret_code = MPI_Barrier(MPI_COMM_WORLD);
+        SMGC_MPICHK(mpi_ret_code, out);
+
+        effe_start = MPI_Wtime();
+        mpi_ret_code = MPI_File_open(MPI_COMM_WORLD, path_buff, amode,
+                                     MPI_INFO_NULL, &mpi_fh);
+        SMGC_MPICHK(mpi_ret_code, out);
+
+        mpi_ret_code = MPI_File_set_view(mpi_fh, (MPI_Offset)0, MPI_CHAR,
+                                         MPI_CHAR, "native", MPI_INFO_NULL);
+        SMGC_MPICHK(mpi_ret_code, out);
+
+        write_start = MPI_Wtime();
+        mpi_ret_code = MPI_File_write_at(mpi_fh, offset, buff, count, type,
+                                         &status);
+        SMGC_MPICHK(mpi_ret_code, out);
+        write_fin = MPI_Wtime();
+
+        gete_start = MPI_Wtime();
+        mpi_ret_code = MPI_Get_elements_x(&status, type, &num_elems);
+        SMGC_MPICHK(mpi_ret_code, out);
+        gete_fin = MPI_Wtime();
+
+        if ((sizeof(char) * file_size) != (size_t)num_elems) {
+            SMGC_ERR_MSG("write size mismatch.  wrote %lld requested %lu\n",
+                         (long long)num_elems, sizeof(char) * file_size);
+            goto out;
+        }
+
+        read_start = MPI_Wtime();
+        mpi_ret_code = MPI_File_read_at(mpi_fh, offset, buff, count, type,
+                                        &status);
+        SMGC_MPICHK(mpi_ret_code, out);
+        read_fin = MPI_Wtime();
+
+        gete_start2 = MPI_Wtime();
+        mpi_ret_code = MPI_Get_elements_x(&status, type, &num_elems);
+        SMGC_MPICHK(mpi_ret_code, out);
+        gete_fin2 = MPI_Wtime();
+
+        mpi_ret_code = MPI_File_close(&mpi_fh);
+        SMGC_MPICHK(mpi_ret_code, out);
+        effe_fin = MPI_Wtime();
+
+        if ((sizeof(char) * file_size) != (size_t)num_elems) {
+            SMGC_ERR_MSG("write/read mismatch.  wrote %lu read %lld\n",
+                         sizeof(char) * file_size, (long long)num_elems);
+            goto out;
+        }
+
+        /* subtract time not spent in benchmarked routines */
+        effe_bw_time_fix = (gete_fin - gete_start) +
+                           (gete_fin2 - gete_start2);
+
+        /* calculate bandwidths */
+
+        /* negative and 0 length file size protection provided by lower level */
+        /* zero value fixup - good enough for our purposes */
+
+        /* effective bandwidth */
+        if (0.0 >= (tmp_dbl = ((effe_fin - effe_start) - effe_bw_time_fix))) {
+            effe_bw = 0.0;
+        }
+        else {
+            effe_bw = ((double)file_size / tmp_dbl / (double)SMGC_MB_SIZE);
+        }
+        /* write bandwidth */
+        if (0.0 >= (tmp_dbl = (write_fin - write_start))) {
+            write_bw = 0.0;
+        }
+        else {
+            write_bw = ((double)file_size / tmp_dbl / (double)SMGC_MB_SIZE);
+        }
+        /* read bandwidth */
+        if (0.0 >= (tmp_dbl = (read_fin - read_start))) {
+            read_bw = 0.0;
+        }
+        else {
+            read_bw = ((double)file_size / tmp_dbl / (double)SMGC_MB_SIZE);
+        }
+
+        /* fill structs for calculating min/max */
+        in_effe.val = effe_bw;
+        in_effe.rank = my_rank;
+        in_wr.val = write_bw;
+        in_wr.rank = my_rank;
+        in_rd.val = read_bw;
+        in_rd.rank = my_rank;
+
+        /* calculate effective bandwidth stats */
+        if (SMGC_SUCCESS != io_stats(in_effe, "effective write bandwidth",
+                                     IO_STATS_MBS)) {
+            goto out;
+        }
+        /* calculate write bandwidth stats */
+        if (SMGC_SUCCESS != io_stats(in_wr, "pure write bandwidth",
+                                     IO_STATS_MBS)) {
+            goto out;
+        }
+        /* calculate read bandwidth stats */
+        if (SMGC_SUCCESS != io_stats(in_rd, "pure read bandwidth",
+                                     IO_STATS_MBS)) {
+            goto out;
+        }
+    }
+
+    /* all is well, set rc accordingly */
+    rc = SMGC_SUCCESS;
+out:
+    lc_type_free(&type);
+    return rc;
+}
+
+#if 0
+/* ////////////////////////////////////////////////////////////////////////// */
+static int
+host_info_exchange(void)
+{
+    unsigned long int *net_nums = (unsigned long int *)
+                                  calloc(num_ranks, sizeof(unsigned long int));
+    int rc = SMGC_ERROR;
+
+    if (NULL == net_nums) {
+        SMGC_ERR_MSG("out of resources\n");
+        return SMGC_ERROR;
+    }
+    if (SMGC_SUCCESS != get_my_global_color(true, &my_color)) {
+        SMGC_ERR_MSG("get_my_global_color failure\n");
+        goto out;
+    }
+
+out:
+    if (NULL != net_nums) free(net_nums);
+    return rc;
+}
+#endif
+
+/* ////////////////////////////////////////////////////////////////////////// */
+static void
+host_table_free(smgc_host_table_t *tab)
+{
+    if (NULL != tab->names) free(tab->names);
+    if (NULL != tab->name_offs) free(tab->name_offs);
+    if (NULL != tab->rank_node) free(tab->rank_node);
+    tab->names = NULL;
+    tab->name_offs = NULL;
+    tab->rank_node = NULL;
+    tab->num_nodes = 0;
+}
+
+/* ////////////////////////////////////////////////////////////////////////// */
+/**
+ * builds the remote host name lookup table. only node leaders exchange their
+ * (variable length) names, which are then handed to the rest of their node,
+ * so the table and the traffic needed to build it grow with the number of
+ * nodes. the only per-rank state is an int mapping each rank to its node.
+ */
+static int
+hostname_exchange(void)
+{
+    int i = 0, my_len = 0, rc = SMGC_ERROR;
+    /* [0]: size of the name table (B) [1]: my node's index */
+    int hdr[2] = {0, 0};
+    int *name_lens = NULL;
+    smgc_tier_t *node = &tiers[1], *leaders = &tiers[2];
+    smgc_host_table_t new_tab = {0, NULL, NULL, NULL}, old_tab;
+
+    new_tab.num_nodes = num_nodes;
+    new_tab.name_offs = (int *)malloc(num_nodes * sizeof(int));
+    SMGC_MEMCHK(new_tab.name_offs, out);
+    new_tab.rank_node = (int *)malloc(num_ranks * sizeof(int));
+    SMGC_MEMCHK(new_tab.rank_node, out);
+
+    SMGC_MPF("       mpi_comm_world: exchanging host name information\n");
+
+    /* node leaders build the name table... */
+    if (MPI_COMM_NULL != leaders->comm) {
+        my_len = (int)strlen(host_name_buff) + 1;
+        name_lens = (int *)malloc(num_nodes * sizeof(int));
+        SMGC_MEMCHK(name_lens, out);
+
+        mpi_ret_code = MPI_Allgather(&my_len, 1, MPI_INT, name_lens, 1,
+                                     MPI_INT, leaders->comm);
+        SMGC_MPICHK(mpi_ret_code, out);
+        for (i = 0; i < num_nodes; ++i) {
+            new_tab.name_offs[i] = hdr[0];
+            hdr[0] += name_lens[i];
+        }
+        new_tab.names = (char *)malloc(hdr[0] * sizeof(char));
+        SMGC_MEMCHK(new_tab.names, out);
+
+        mpi_ret_code = MPI_Allgatherv(host_name_buff, my_len, MPI_CHAR,
+                                      new_tab.names, name_lens,
+                                      new_tab.name_offs, MPI_CHAR,
+                                      leaders->comm);
+        SMGC_MPICHK(mpi_ret_code, out);
+        hdr[1] = leaders->rank;
+    }
+
+    /* ...and hand it to the rest of their node */
+    mpi_ret_code = MPI_Bcast(hdr, 2, MPI_INT, 0, node->comm);
+    SMGC_MPICHK(mpi_ret_code, out);
+    if (NULL == new_tab.names) {
+        new_tab.names = (char *)malloc(hdr[0] * sizeof(char));
+        SMGC_MEMCHK(new_tab.names, out);
+    }
+    mpi_ret_code = MPI_Bcast(new_tab.name_offs, num_nodes, MPI_INT, 0,
+                             node->comm);
+    SMGC_MPICHK(mpi_ret_code, out);
+    mpi_ret_code = MPI_Bcast(new_tab.names, hdr[0], MPI_CHAR, 0, node->comm);
+    SMGC_MPICHK(mpi_ret_code, out);
+
+    /* every rank learns which node every other rank lives on */
+    mpi_ret_code = MPI_Allgather(&hdr[1], 1, MPI_INT, new_tab.rank_node, 1,
+                                 MPI_INT, MPI_COMM_WORLD);
+    SMGC_MPICHK(mpi_ret_code, out);
+
+    SMGC_MPF("       mpi_comm_world: host table: %d node(s), %d B of names, "
+             "%lu B rank index\n", num_nodes, hdr[0],
+             (unsigned long)(num_ranks * sizeof(int)));
+
+    /* the watchdog thread may be reading the old table */
+#ifdef HAVE_PTHREAD_H
+    pthread_mutex_lock(&wd_lock);
+#endif
+    old_tab = host_table;
+    host_table = new_tab;
+#ifdef HAVE_PTHREAD_H
+    pthread_mutex_unlock(&wd_lock);
+#endif
+    new_tab = old_tab;
+
+    rc = SMGC_SUCCESS;
+out:
+    /* on success, this is the table that was replaced */
+    host_table_free(&new_tab);
+    if (NULL != name_lens) free(name_lens);
+    return rc;
+}
+
+/* ////////////////////////////////////////////////////////////////////////// */
+static int
+small_allreduce_max(void)
+{
+    double send_buff = (double)my_rank, recv_buff = 0.0;
+    smgc_wd_op_t *wd_op = NULL;
+
+    SMGC_MPF("       message size: %d B\n", (int)sizeof(double));
+    SMGC_MPF("       mpi_comm_world: mpi_allreducing\n");
+
+    wd_op = wd_op_begin("small_allreduce_max", 0);
+    wd_op_step(wd_op, 0, -1, -1);
+    mpi_ret_code = MPI_Allreduce(&send_buff, &recv_buff, 1, MPI_DOUBLE,
+                                 MPI_MAX, MPI_COMM_WORLD);
+    wd_op_end(wd_op);
+    SMGC_MPICHK(mpi_ret_code, error);
+
+    SMGC_MPF("       mpi_comm_world: verifying result\n");
+
+    /* yes, i do want to do it this way :-) */
+    if (recv_buff != (double)(num_ranks - 1)) {
+        SMGC_ERR_MSG("invalid result detected\n");
+        goto error;
+    }
+
+    return SMGC_SUCCESS;
+error:
+    return SMGC_ERROR;
+}
+
+/* ////////////////////////////////////////////////////////////////////////// */
+/**
+ * does collective coll need num_ranks blocks per rank (as opposed to one)?
+ */
+static bool
+coll_scales(int coll)
+{
+    switch (coll) {
+        case SMGC_COLL_ALLGATHER:
+        case SMGC_COLL_ALLTOALL:
+        case SMGC_COLL_REDUCE_SCATTER:
+        case SMGC_COLL_GATHER:
+        case SMGC_COLL_SCATTER:
+            return true;
+        default:
+            return false;
+    }
+}
+
+/* ////////////////////////////////////////////////////////////////////////// */
+/**
+ * fills the send buffer of collective coll (count elements per block). every
+ * element is a small integer, so the sums coll_check expects are exact.
+ */
+static void
+coll_init(int coll, double *send, int count)
+{
+    int i = 0, j = 0;
+
+    switch (coll) {
+        case SMGC_COLL_ALLREDUCE:
+        case SMGC_COLL_REDUCE:
+        case SMGC_COLL_ALLGATHER:
+        case SMGC_COLL_GATHER:
+            for (i = 0; i < count; ++i) {
+                send[i] = (double)(my_rank + i);
+            }
+            break;
+        case SMGC_COLL_ALLTOALL:
+            /* block j goes to rank j */
+            for (j = 0; j < num_ranks; ++j) {
+                for (i = 0; i < count; ++i) {
+                    send[j * count + i] =
+                        (double)my_rank * num_ranks + j + i;
+                }
+            }
+            break;
+        case SMGC_COLL_REDUCE_SCATTER:
+            for (i = 0; i < num_ranks * count; ++i) {
+                send[i] = (double)(my_rank + i);
+            }
+            break;
+        case SMGC_COLL_SCATTER:
+            /* only the root's matters */
+            for (i = 0; i < num_ranks * count; ++i) {
+                send[i] = (double)i;
+            }
+            break;
+        default:
+            break;
+    }
+}
+
+/* ////////////////////////////////////////////////////////////////////////// */
+/**
+ * runs collective coll over mpi_comm_world. returns an mpi return code.
+ */
+static int
+coll_run(int coll, double *send, double *recv, int count)
+{
+    switch (coll) {
+        case SMGC_COLL_ALLREDUCE:
+            return MPI_Allreduce(send, recv, count, MPI_DOUBLE, MPI_SUM,
+                                 MPI_COMM_WORLD);
+        case SMGC_COLL_REDUCE:
+            return MPI_Reduce(send, recv, count, MPI_DOUBLE, MPI_SUM,
+                              SMGC_MASTER_RANK, MPI_COMM_WORLD);
+        case SMGC_COLL_ALLGATHER:
+            return MPI_Allgather(send, count, MPI_DOUBLE, recv, count,
+                                 MPI_DOUBLE, MPI_COMM_WORLD);
+        case SMGC_COLL_ALLTOALL:
+            return MPI_Alltoall(send, count, MPI_DOUBLE, recv, count,
+                                MPI_DOUBLE, MPI_COMM_WORLD);
+        case SMGC_COLL_REDUCE_SCATTER:
+            return MPI_Reduce_scatter_block(send, recv, count, MPI_DOUBLE,
+                                            MPI_SUM, MPI_COMM_WORLD);
+        case SMGC_COLL_GATHER:
+            return MPI_Gather(send, count, MPI_DOUBLE, recv, count,
+                              MPI_DOUBLE, SMGC_MASTER_RANK, MPI_COMM_WORLD);
+        case SMGC_COLL_SCATTER:
+            return MPI_Scatter(send, count, MPI_DOUBLE, recv, count,
+                               MPI_DOUBLE, SMGC_MASTER_RANK, MPI_COMM_WORLD);
+        case SMGC_COLL_BARRIER:
+            return MPI_Barrier(MPI_COMM_WORLD);
+        default:
+            return MPI_ERR_OTHER;
+    }
+}
+
+/* ////////////////////////////////////////////////////////////////////////// */
+/**
+ * checks the result of collective coll (initialized by coll_init) against
+ * its closed form.
+ */
+static int
+coll_check(int coll, const double *recv, int count)
+{
+    int i = 0, n = 0;
+    double nr = (double)num_ranks, tri = nr * (nr - 1.0) / 2.0;
+    double expect = 0.0;
+
+    switch (coll) {
+        case SMGC_COLL_REDUCE:
+        case SMGC_COLL_GATHER:
+            /* only the root has a result */
+            if (SMGC_MASTER_RANK != my_rank) {
+                return SMGC_SUCCESS;
+            }
+            n = (SMGC_COLL_GATHER == coll) ? num_ranks * count : count;
+            break;
+        case SMGC_COLL_ALLGATHER:
+        case SMGC_COLL_ALLTOALL:
+            n = num_ranks * count;
+            break;
+        case SMGC_COLL_ALLREDUCE:
+        case SMGC_COLL_REDUCE_SCATTER:
+        case SMGC_COLL_SCATTER:
+            n = count;
+            break;
+        default:
+            return SMGC_SUCCESS;
+    }
+
+    for (i = 0; i < n; ++i) {
+        switch (coll) {
+            case SMGC_COLL_ALLREDUCE:
+            case SMGC_COLL_REDUCE:
+                /* sum over r of (r + i) */
+                expect = tri + nr * i;
+                break;
+            case SMGC_COLL_ALLGATHER:
+            case SMGC_COLL_GATHER:
+                expect = (double)(i / count + i % count);
+                break;
+            case SMGC_COLL_ALLTOALL:
+                expect = (double)(i / count) * nr + my_rank + i % count;
+                break;
+            case SMGC_COLL_REDUCE_SCATTER:
+                expect = tri + nr * ((double)my_rank * count + i);
+                break;
+            case SMGC_COLL_SCATTER:
+                expect = (double)my_rank * count + i;
+                break;
+        }
+        if (recv[i] != expect) {
+            SMGC_ERR_MSG("%s: invalid result detected on rank %d (%s): "
+                         "element %d is %.1f, expected %.1f\n",
+                         coll_names[coll], my_rank, host_name_buff, i,
+                         recv[i], expect);
+            return SMGC_ERROR;
+        }
+    }
+    return SMGC_SUCCESS;
+}
+
+/* ////////////////////////////////////////////////////////////////////////// */
+/**
+ * prints a one line summary of the time (s) each rank spent in a single call
+ * of collective coll with a size B message.
+ */
+static int
+coll_time_stats(int coll, int size, double t)
+{
+    double_int_t in = {t * 1e6, my_rank}, max = {0.0, 0};
+    double min = 0.0, sum = 0.0;
+
+    mpi_ret_code = MPI_Reduce(&in, &max, 1, MPI_DOUBLE_INT, MPI_MAXLOC,
+                              SMGC_MASTER_RANK, MPI_COMM_WORLD);
+    SMGC_MPICHK(mpi_ret_code, err);
+    mpi_ret_code = MPI_Reduce(&in.val, &min, 1, MPI_DOUBLE, MPI_MIN,
+                              SMGC_MASTER_RANK, MPI_COMM_WORLD);
+    SMGC_MPICHK(mpi_ret_code, err);
+    mpi_ret_code = MPI_Reduce(&in.val, &sum, 1, MPI_DOUBLE, MPI_SUM,
+                              SMGC_MASTER_RANK, MPI_COMM_WORLD);
+    SMGC_MPICHK(mpi_ret_code, err);
+
+    SMGC_MPF("       %-14s %10d %12.3f %12.3f %12.3f  %06d (%s)\n",
+             coll_names[coll], size, min, sum / num_ranks, max.val, max.rank,
+             get_rhn(max.rank));
+    return SMGC_SUCCESS;
+err:
+    return SMGC_ERROR;
+}
+
+/* ////////////////////////////////////////////////////////////////////////// */
+/**
+ * times allreduce, reduce, allgather, alltoall, reduce_scatter, gather,
+ * scatter and barrier over a range of message sizes and checks every result
+ * against its closed form. message sizes are per rank (or per block, for the
+ * collectives that move a block per rank) and grow by SMGC_COLL_SIZE_FACTOR
+ * up to msg_size, which also bounds the largest buffer any collective needs.
+ */
+static int
+coll_suite(void)
+{
+    int i = 0, coll = 0, count = 0, size = 0, rc = SMGC_ERROR;
+    int max_count = int_msg_size() / (int)sizeof(double);
+    double *send = NULL, *recv = NULL;
+    double start = 0.0, elapsed = 0.0;
+    smgc_wd_op_t *wd_op = NULL;
+
+    if (max_count < 1) {
+        SMGC_MPF("       message size < %d B - skipping\n",
+                 (int)sizeof(double));
+        return SMGC_SUCCESS;
+    }
+
+    send = (double *)arena_get(max_count * sizeof(double));
+    SMGC_MEMCHK(send, out);
+    recv = (double *)arena_get(max_count * sizeof(double));
+    SMGC_MEMCHK(recv, out);
+
+    SMGC_MPF("       message sizes: %d B to at most %d B (x%d)\n",
+             (int)sizeof(double), max_count * (int)sizeof(double),
+             SMGC_COLL_SIZE_FACTOR);
+    SMGC_MPF("       timed calls per size: %d\n", SMGC_COLL_NUM_ITRS);
+    SMGC_MPF("       %-14s %10s %12s %12s %12s  %s\n", "collective",
+             "size (B)", "min (us)", "ave (us)", "max (us)", "slowest rank");
+
+    for (coll = 0; coll < SMGC_NUM_COLLS; ++coll) {
+        if (coll_scales(coll) && max_count / num_ranks < 1) {
+            SMGC_MPF("       %-14s skipped: needs %d B buffers\n",
+                     coll_names[coll], num_ranks * (int)sizeof(double));
+            continue;
+        }
+        wd_op = wd_op_begin(coll_names[coll], 0);
+        for (count = 1; count <= max_count; count *= SMGC_COLL_SIZE_FACTOR) {
+            if (coll_scales(coll) && count > max_count / num_ranks) {
+                break;
+            }
+            coll_init(coll, send, count);
+            /* one untimed call to warm up, then the timed ones */
+            for (i = 0; i <= SMGC_COLL_NUM_ITRS; ++i) {
+                if (1 == i) {
+                    mpi_ret_code = MPI_Barrier(MPI_COMM_WORLD);
+                    SMGC_MPICHK(mpi_ret_code, out);
+                    start = MPI_Wtime();
+                }
+                wd_op_step(wd_op, i, -1, -1);
+                mpi_ret_code = coll_run(coll, send, recv, count);
+                SMGC_MPICHK(mpi_ret_code, out);
+            }
+            elapsed = (MPI_Wtime() - start) / SMGC_COLL_NUM_ITRS;
+
+            size = (SMGC_COLL_BARRIER == coll) ? 0 :
+                   count * (int)sizeof(double);
+
+            if (SMGC_SUCCESS != coll_check(coll, recv, count) ||
+                SMGC_SUCCESS != coll_time_stats(coll, size, elapsed)) {
+                goto out;
+            }
+            /* message size means nothing to a barrier */
+            if (SMGC_COLL_BARRIER == coll ||
+                count > max_count / SMGC_COLL_SIZE_FACTOR) {
+                break;
+            }
+        }
+        wd_op_end(wd_op);
+        wd_op = NULL;
+    }
+
+    rc = SMGC_SUCCESS;
+out:
+    wd_op_end(wd_op);
+    return rc;
+}
+
+/* ////////////////////////////////////////////////////////////////////////// */
+/**
+ * size of the point-to-point messages used by the overlap test - well past
+ * msg_size and any eager limit.
+ */
+static size_t
+overlap_p2p_size(void)
+{
+    size_t size = (size_t)int_msg_size() * SMGC_OVERLAP_P2P_MULT;
+
+    if (size > SMGC_INT_MSG_MAX) {
+        return SMGC_INT_MSG_MAX;
+    }
+    return (size < SMGC_OVERLAP_P2P_MIN) ? SMGC_OVERLAP_P2P_MIN : size;
+}
+
+/* ////////////////////////////////////////////////////////////////////////// */
+/**
+ * burns the cpu for (at least) secs seconds without making progress calls.
+ * returns the time actually spent.
+ */
+static double
+compute_for(double secs)
+{
+    int i = 0;
+    volatile double x = 1.0;
+    double start = MPI_Wtime();
+
+    do {
+        for (i = 0; i < 1024; ++i) {
+            x = x * 1.0000001 + 1e-9;
+        }
+    } while (MPI_Wtime() - start < secs);
+
+    return MPI_Wtime() - start;
+}
+
+/* ////////////////////////////////////////////////////////////////////////// */
+/**
+ * starts non-blocking operation op (size B per message or block). fills
+ * reqs[0] and reqs[1]. returns an mpi return code.
+ */
+static int
+overlap_post(int op, char *sbuf, char *rbuf, int size, MPI_Request *reqs)
+{
+    int tag = 42, r_neighbor = (my_rank + 1) % num_ranks,
+        l_neighbor = (my_rank + num_ranks - 1) % num_ranks;
+
+    reqs[0] = reqs[1] = MPI_REQUEST_NULL;
+    switch (op) {
+        case SMGC_OVL_P2P:
+            mpi_ret_code = MPI_Irecv(rbuf, size, MPI_CHAR, l_neighbor, tag,
+                                     MPI_COMM_WORLD, &reqs[0]);
+            if (MPI_SUCCESS != mpi_ret_code) {
+                return mpi_ret_code;
+            }
+            return MPI_Isend(sbuf, size, MPI_CHAR, r_neighbor, tag,
+                             MPI_COMM_WORLD, &reqs[1]);
+        case SMGC_OVL_IALLREDUCE:
+            return MPI_Iallreduce(sbuf, rbuf, size / (int)sizeof(double),
+                                  MPI_DOUBLE, MPI_SUM, MPI_COMM_WORLD,
+                                  &reqs[0]);
+        case SMGC_OVL_IBCAST:
+            return MPI_Ibcast(SMGC_MASTER_RANK == my_rank ? sbuf : rbuf, size,
+                              MPI_CHAR, SMGC_MASTER_RANK, MPI_COMM_WORLD,
+                              &reqs[0]);
+        case SMGC_OVL_IALLTOALL:
+            return MPI_Ialltoall(sbuf, size, MPI_CHAR, rbuf, size, MPI_CHAR,
+                                 MPI_COMM_WORLD, &reqs[0]);
+        case SMGC_OVL_IBARRIER:
+            return MPI_Ibarrier(MPI_COMM_WORLD, &reqs[0]);
+        default:
+            return MPI_ERR_OTHER;
+    }
+}
+
+/* ////////////////////////////////////////////////////////////////////////// */
+/**
+ * average time (s) of SMGC_OVERLAP_NUM_ITRS rounds of: start op, compute for
+ * comp seconds, wait for op.
+ */
+static int
+overlap_time(int op, char *sbuf, char *rbuf, int size, double comp,
+             double *t)
+{
+    int i = 0;
+    double start = 0.0;
+    MPI_Request reqs[2];
+
+    mpi_ret_code = MPI_Barrier(MPI_COMM_WORLD);
+    SMGC_MPICHK(mpi_ret_code, err);
+
+    start = MPI_Wtime();
+    for (i = 0; i < SMGC_OVERLAP_NUM_ITRS; ++i) {
+        mpi_ret_code = overlap_post(op, sbuf, rbuf, size, reqs);
+        SMGC_MPICHK(mpi_ret_code, err);
+        if (comp > 0.0) {
+            compute_for(comp);
+        }
+        mpi_ret_code = MPI_Waitall(2, reqs, MPI_STATUSES_IGNORE);
+        SMGC_MPICHK(mpi_ret_code, err);
+    }
+    *t = (MPI_Wtime() - start) / SMGC_OVERLAP_NUM_ITRS;
+
+    return SMGC_SUCCESS;
+err:
+    return SMGC_ERROR;
+}
+
+/* ////////////////////////////////////////////////////////////////////////// */
+/**
+ * does the mpi library make asynchronous progress? for a rendezvous-size
+ * isend/irecv ring and several non-blocking collectives, times the operation
+ * alone (t_comm), a compute loop of the same length alone (t_comp) and both
+ * overlapped (t_ovl). the overlap fraction is
+ * (t_comm + t_comp - t_ovl) / min(t_comm, t_comp): 100 % means the
+ * communication was completely hidden, 0 % means it made no progress until
+ * the wait.
+ */
+static int
+overlap(void)
+{
+    int i = 0, op = 0, size = 0, count = 0, rc = SMGC_ERROR;
+    int l_neighbor = (my_rank + num_ranks - 1) % num_ranks;
+    size_t p2p_size = overlap_p2p_size();
+    char *sbuf = NULL, *rbuf = NULL;
+    char label[64];
+    double t_comm = 0.0, t_comp = 0.0, t_ovl = 0.0, t_min = 0.0;
+    /* [0]: comm [1]: compute [2]: overlapped */
+    double in_t[3] = {0.0, 0.0, 0.0}, sum_t[3] = {0.0, 0.0, 0.0};
+    double_int_t in_frac = {0.0, 0};
+    smgc_wd_op_t *wd_op = NULL;
+
+    sbuf = (char *)arena_get(p2p_size);
+    SMGC_MEMCHK(sbuf, out);
+    rbuf = (char *)arena_get(p2p_size);
+    SMGC_MEMCHK(rbuf, out);
+
+    SMGC_MPF("       timed operations per measurement: %d\n",
+             SMGC_OVERLAP_NUM_ITRS);
+
+    wd_op = wd_op_begin("overlap", 0);
+
+    for (op = 0; op < SMGC_NUM_OVL_OPS; ++op) {
+        switch (op) {
+            case SMGC_OVL_P2P:
+                size = (int)p2p_size;
+                payload_prep(sbuf, size, my_rank,
+                             (my_rank + 1) % num_ranks, op);
+                break;
+            case SMGC_OVL_IALLREDUCE:
+                count = int_msg_size() / (int)sizeof(double);
+                count = (count < 1) ? 1 : count;
+                size = count * (int)sizeof(double);
+                for (i = 0; i < count; ++i) {
+                    ((double *)sbuf)[i] = 1.0;
+                }
+                break;
+            case SMGC_OVL_IBCAST:
+                size = int_msg_size();
+                payload_prep(sbuf, size, SMGC_MASTER_RANK,
+                             SMGC_PAYLOAD_ANY_RANK, op);
+                break;
+            case SMGC_OVL_IALLTOALL:
+                /* a block per rank - msg_size in all */
+                size = int_msg_size() / num_ranks;
+                size = (size < 1) ? 1 : size;
+                memset(sbuf, 'x', (size_t)size * num_ranks);
+                break;
+            default:
+                size = 0;
+                break;
+        }
+
+        wd_op_step(wd_op, op, -1, -1);
+        if (SMGC_SUCCESS != overlap_time(op, sbuf, rbuf, size, 0.0,
+                                         &t_comm)) {
+            goto out;
+        }
+        /* compute for as long as the communication takes */
+        for (i = 0, t_comp = 0.0; i < SMGC_OVERLAP_NUM_ITRS; ++i) {
+            t_comp += compute_for(t_comm);
+        }
+        t_comp /= SMGC_OVERLAP_NUM_ITRS;
+        wd_op_step(wd_op, op, -1, -1);
+        if (SMGC_SUCCESS != overlap_time(op, sbuf, rbuf, size, t_comm,
+                                         &t_ovl)) {
+            goto out;
+        }
+
+        /* check what the last round delivered */
+        if (SMGC_OVL_P2P == op &&
+            SMGC_SUCCESS != payload_verify(rbuf, size, l_neighbor, my_rank,
+                                           op)) {
+            goto out;
+        }
+        if (SMGC_OVL_IBCAST == op && SMGC_MASTER_RANK != my_rank &&
+            SMGC_SUCCESS != payload_verify(rbuf, size, SMGC_MASTER_RANK,
+                                           SMGC_PAYLOAD_ANY_RANK, op)) {
+            goto out;
+        }
+        for (i = 0; SMGC_OVL_IALLREDUCE == op && i < count; ++i) {
+            if (((double *)rbuf)[i] != (double)num_ranks) {
+                SMGC_ERR_MSG("%s: invalid result detected on rank %d (%s)\n",
+                             ovl_names[op], my_rank, host_name_buff);
+                goto out;
+            }
+        }
+
+        t_min = (t_comm < t_comp) ? t_comm : t_comp;
+        in_frac.val = (t_min > 0.0) ?
+                      ((t_comm + t_comp - t_ovl) / t_min * 100.0) : 0.0;
+        in_frac.val = (in_frac.val < 0.0) ? 0.0 :
+                      (in_frac.val > 100.0) ? 100.0 : in_frac.val;
+        in_frac.rank = my_rank;
+        in_t[0] = t_comm * 1e6;
+        in_t[1] = t_comp * 1e6;
+        in_t[2] = t_ovl * 1e6;
+
+        mpi_ret_code = MPI_Reduce(in_t, sum_t, 3, MPI_DOUBLE, MPI_SUM,
+                                  SMGC_MASTER_RANK, MPI_COMM_WORLD);
+        SMGC_MPICHK(mpi_ret_code, out);
+
+        SMGC_MPF("   --- %s: %d B\n", ovl_names[op], size);
+        SMGC_MPF("          ave comm/compute/overlapped time: %.3f/%.3f/%.3f "
+                 "%s\n", sum_t[0] / num_ranks, sum_t[1] / num_ranks,
+                 sum_t[2] / num_ranks, SMGC_TIME_US_UNIT_STR);
+        snprintf(label, sizeof(label), "%s overlap", ovl_names[op]);
+        if (SMGC_SUCCESS != io_stats(in_frac, label, IO_STATS_PCT)) {
+            goto out;
+        }
+    }
+    wd_op_end(wd_op);
+    wd_op = NULL;
+
+    if (SMGC_SUCCESS != payload_verify_stats(MPI_COMM_WORLD)) {
+        goto out;
+    }
+
+    rc = SMGC_SUCCESS;
+out:
+    wd_op_end(wd_op);
+    return rc;
+}
+
+/* ////////////////////////////////////////////////////////////////////////// */
+/**
+ * all to root as an incast: every sender fires SMGC_INCAST_NUM_MSGS messages
+ * at the root at once while the root keeps a window of any source receives
+ * posted, so senders compete for root ingress the way they do at an i/o
+ * aggregator. the root reports its ingress bandwidth over time, when each
+ * sender's last message arrived, and which senders were starved.
+ */
+static int
+all_to_root_incast(void)
+{
+    int i = 0, slot = 0, window = 0, total = 0, posted = 0, received = 0;
+    int num_starved = 0, buff_size = int_msg_size(), rc = SMGC_ERROR;
+    char *char_buff = NULL;
+    /* root only: arrival time of every message and each sender's last one */
+    double *msg_time = NULL, *done_time = NULL, *sorted = NULL;
+    double start = 0.0, now = 0.0, duration = 0.0, median = 0.0;
+    double verify_start = 0.0, bucket_len = 0.0;
+    double bucket_bytes[SMGC_INCAST_BUCKETS];
+    int *done_rank = NULL;
+    MPI_Request *reqs = NULL;
+    MPI_Status status;
+    smgc_wd_op_t *wd_op = NULL;
+
+    total = (num_ranks - 1) * SMGC_INCAST_NUM_MSGS;
+    window = window_msgs(buff_size);
+    if (window > total) window = total;
+
+    SMGC_MPF("       message size: %d B\n", buff_size);
+    SMGC_MPF("       incast: %d messages per sender, %d receives posted\n",
+             SMGC_INCAST_NUM_MSGS, window);
+
+    if (SMGC_MASTER_RANK != my_rank) {
+        char_buff = (char *)arena_get(buff_size * sizeof(char));
+        SMGC_MEMCHK(char_buff, out);
+        reqs = (MPI_Request *)malloc(SMGC_INCAST_NUM_MSGS *
+                                     sizeof(MPI_Request));
+        SMGC_MEMCHK(reqs, out);
+        payload_prep(char_buff, buff_size, my_rank, SMGC_MASTER_RANK, 0);
+    }
+    else if (total > 0) {
+        char_buff = (char *)arena_get((size_t)window * buff_size);
+        SMGC_MEMCHK(char_buff, out);
+        reqs = (MPI_Request *)malloc(window * sizeof(MPI_Request));
+        SMGC_MEMCHK(reqs, out);
+        msg_time = (double *)malloc(total * sizeof(double));
+        SMGC_MEMCHK(msg_time, out);
+        done_time = (double *)calloc(num_ranks, sizeof(double));
+        SMGC_MEMCHK(done_time, out);
+        sorted = (double *)malloc(num_ranks * sizeof(double));
+        SMGC_MEMCHK(sorted, out);
+        done_rank = (int *)malloc(num_ranks * sizeof(int));
+        SMGC_MEMCHK(done_rank, out);
+        /* pre-post the window before anyone starts sending */
+        for (posted = 0; posted < window; ++posted) {
+            mpi_ret_code = MPI_Irecv(char_buff + (size_t)posted * buff_size,
+                                     buff_size, MPI_CHAR, MPI_ANY_SOURCE,
+                                     MPI_ANY_TAG, MPI_COMM_WORLD,
+                                     &reqs[posted]);
+            SMGC_MPICHK(mpi_ret_code, out);
+        }
+    }
+
+    mpi_ret_code = MPI_Barrier(MPI_COMM_WORLD);
+    SMGC_MPICHK(mpi_ret_code, out);
+
+    wd_op = wd_op_begin("large_all_to_root_ptp", 0);
+
+    if (SMGC_MASTER_RANK != my_rank) {
+        for (i = 0; i < SMGC_INCAST_NUM_MSGS; ++i) {
+            mpi_ret_code = MPI_Isend(char_buff, buff_size, MPI_CHAR,
+                                     SMGC_MASTER_RANK, i, MPI_COMM_WORLD,
+                                     &reqs[i]);
+            SMGC_MPICHK(mpi_ret_code, out);
+        }
+        wd_op_step(wd_op, 0, my_rank, SMGC_MASTER_RANK);
+        mpi_ret_code = MPI_Waitall(SMGC_INCAST_NUM_MSGS, reqs,
+                                   MPI_STATUSES_IGNORE);
+        SMGC_MPICHK(mpi_ret_code, out);
+    }
+    /* i am the root */
+    else {
+        verify_start = verify_time;
+        start = MPI_Wtime();
+        for (received = 0; received < total; ++received) {
+            wd_op_step(wd_op, received, -1, my_rank);
+            mpi_ret_code = MPI_Waitany(window, reqs, &slot, &status);
+            SMGC_MPICHK(mpi_ret_code, out);
+            /* keep verification out of the arrival times */
+            now = MPI_Wtime() - start - (verify_time - verify_start);
+            msg_time[received] = now;
+            done_time[status.MPI_SOURCE] = now;
+
+            if (SMGC_SUCCESS != payload_verify(char_buff +
+                                               (size_t)slot * buff_size,
+                                               buff_size, status.MPI_SOURCE,
+                                               my_rank, 0)) {
+                goto out;
+            }
+            if (posted < total) {
+                mpi_ret_code = MPI_Irecv(char_buff + (size_t)slot * buff_size,
+                                         buff_size, MPI_CHAR, MPI_ANY_SOURCE,
+                                         MPI_ANY_TAG, MPI_COMM_WORLD,
+                                         &reqs[slot]);
+                SMGC_MPICHK(mpi_ret_code, out);
+                ++posted;
+            }
+        }
+    }
+    wd_op_end(wd_op);
+    wd_op = NULL;
+
+    if (SMGC_MASTER_RANK == my_rank && total > 0) {
+        duration = msg_time[total - 1];
+        bucket_len = duration / SMGC_INCAST_BUCKETS;
+        memset(bucket_bytes, 0, sizeof(bucket_bytes));
+        for (i = 0; i < total; ++i) {
+            slot = (bucket_len > 0.0) ? (int)(msg_time[i] / bucket_len) : 0;
+            if (slot >= SMGC_INCAST_BUCKETS) {
+                slot = SMGC_INCAST_BUCKETS - 1;
+            }
+            bucket_bytes[slot] += (double)buff_size;
+        }
+        SMGC_MPF("   --- root ingress bandwidth: %.3f %s over %.6f s\n",
+                 (duration > 0.0) ? ((double)total * buff_size / duration /
+                                     (double)SMGC_MB_SIZE) : 0.0,
+                 SMGC_MBS_UNIT_STR, duration);
+        for (i = 0; i < SMGC_INCAST_BUCKETS && bucket_len > 0.0; ++i) {
+            SMGC_MPF("          [%.6f, %.6f) s: %.3f %s\n", i * bucket_len,
+                     (i + 1) * bucket_len,
+                     bucket_bytes[i] / bucket_len / (double)SMGC_MB_SIZE,
+                     SMGC_MBS_UNIT_STR);
+        }
+
+        /* when did each sender's last message arrive? */
+        for (i = 0, slot = 0; i < num_ranks; ++i) {
+            if (SMGC_MASTER_RANK != i) {
+                sorted[slot++] = done_time[i];
+            }
+        }
+        qsort(sorted, slot, sizeof(double), &qsort_cmp_dbl);
+        median = sorted[slot / 2];
+        SMGC_MPF("   --- sender completion latency:\n");
+        SMGC_MPF("          min: %.3f %s, median: %.3f %s, max: %.3f %s\n",
+                 sorted[0] * 1e6, SMGC_TIME_US_UNIT_STR, median * 1e6,
+                 SMGC_TIME_US_UNIT_STR, sorted[slot - 1] * 1e6,
+                 SMGC_TIME_US_UNIT_STR);
+
+        /* under fair service, completions spread evenly up to 2x median */
+        for (i = 0; i < num_ranks; ++i) {
+            if (SMGC_MASTER_RANK != i &&
+                done_time[i] > SMGC_INCAST_STARVE_FACTOR * median) {
+                done_rank[num_starved++] = i;
+            }
+        }
+        SMGC_MPF("   --- starved senders (done after %.1fx median): %d\n",
+                 SMGC_INCAST_STARVE_FACTOR, num_starved);
+        for (i = 0; i < num_starved && i < SMGC_INCAST_MAX_LISTED; ++i) {
+            SMGC_MPF("          %06d (%s): %.3f %s\n", done_rank[i],
+                     get_rhn(done_rank[i]), done_time[done_rank[i]] * 1e6,
+                     SMGC_TIME_US_UNIT_STR);
+        }
+        if (num_starved > SMGC_INCAST_MAX_LISTED) {
+            SMGC_MPF("          ... and %d more\n",
+                     num_starved - SMGC_INCAST_MAX_LISTED);
+        }
+    }
+    if (SMGC_SUCCESS != payload_verify_stats(MPI_COMM_WORLD)) {
+        goto out;
+    }
+
+    rc = SMGC_SUCCESS;
+out:
+    wd_op_end(wd_op);
+    if (NULL != reqs) free(reqs);
+    if (NULL != msg_time) free(msg_time);
+    if (NULL != done_time) free(done_time);
+    if (NULL != sorted) free(sorted);
+    if (NULL != done_rank) free(done_rank);
+    return rc;
+}
+
+/* ////////////////////////////////////////////////////////////////////////// */
+/**
+ * potentially a very synchronous all to root point-to-point implementation.
+ */
+static int
+large_all_to_root_ptp(void)
+{
+    int buff_size   = int_msg_size();
+    int src_rank    = 0, tag = 0;
+    int rc          = SMGC_ERROR;
+    char *char_buff = NULL;
+    char *del       = "\b\b\b\b\b\b\b\b\b\b\b\b\b";
+    smgc_wd_op_t *wd_op = NULL;
+    MPI_Status status;
+
+    if (do_incast) {
+        return all_to_root_incast();
+    }
+
+    if (NULL == (char_buff = (char *)arena_get(buff_size * sizeof(char)))) {
+        return SMGC_ERROR;
+    }
+
+    SMGC_MPF("       message size: %d B\n", buff_size);
+
+    /* if we are here, let the games begin */
+
+    wd_op = wd_op_begin("large_all_to_root_ptp", 0);
+
+    if (SMGC_MASTER_RANK != my_rank) {
+        payload_prep(char_buff, buff_size, my_rank, SMGC_MASTER_RANK, 0);
+        wd_op_step(wd_op, 0, my_rank, SMGC_MASTER_RANK);
+        mpi_ret_code = MPI_Send(char_buff, buff_size, MPI_CHAR,
+                                SMGC_MASTER_RANK, tag, MPI_COMM_WORLD);
+        SMGC_MPICHK(mpi_ret_code, out);
+    }
+    /* i am the root */
+    else {
+        SMGC_MPF("       mpi_comm_world: mpi_sending to rank %d - ",
+                 SMGC_MASTER_RANK);
+        for (src_rank = 0; src_rank < num_ranks; ++src_rank) {
+            if (my_rank != src_rank) {
+                SMGC_MPF("%s%06d/%06d%s", 1 == src_rank ? "" : del, src_rank,
+                         (num_ranks - 1),
+                         (num_ranks  -1) == src_rank ? "\n" : "");
+
+                wd_op_step(wd_op, src_rank, src_rank, my_rank);
+                mpi_ret_code = MPI_Recv(char_buff, buff_size, MPI_CHAR,
+                                        src_rank, tag, MPI_COMM_WORLD, &status);
+                SMGC_MPICHK(mpi_ret_code, out);
+
+                if (SMGC_SUCCESS != payload_verify(char_buff, buff_size,
+                                                   src_rank, my_rank, 0)) {
+                    goto out;
+                }
+            }
+        }
+    }
+    wd_op_end(wd_op);
+    wd_op = NULL;
+    if (SMGC_SUCCESS != payload_verify_stats(MPI_COMM_WORLD)) {
+        goto out;
+    }
+    /* we made it - rainbows and butterflies */
+    rc = SMGC_SUCCESS;
+out:
+    wd_op_end(wd_op);
+    return rc;
+}
+
+/* ////////////////////////////////////////////////////////////////////////// */
+static int
+root_bcast_tier(smgc_tier_t *tier)
+{
+    int root_wrank = tier_wrank(tier, 0), rc = SMGC_ERROR;
+    size_t buff_size = msg_size;
+    char *char_buff = NULL;
+    double elapsed = 0.0;
+    double_int_t in_bw = {0.0, 0};
+    smgc_wd_op_t *wd_op = NULL;
+
+    if (NULL == (char_buff = (char *)arena_get(buff_size * sizeof(char)))) {
+        return SMGC_ERROR;
+    }
+
+    SMGC_MPF("       message size: %lu B\n", (unsigned long)buff_size);
+    SMGC_MPF("       rank %06d (%s): broadcasting to %s\n", my_rank,
+             host_name_buff, tier->name);
+
+    if (0 == tier->rank) {
+        payload_prep(char_buff, buff_size, root_wrank, SMGC_PAYLOAD_ANY_RANK,
+                     0);
+    }
+
+    mpi_ret_code = MPI_Barrier(tier->comm);
+    SMGC_MPICHK(mpi_ret_code, out);
+
+    wd_op = wd_op_begin("root_bcast", 0);
+    wd_op_step(wd_op, 0, root_wrank, -1);
+    elapsed = MPI_Wtime();
+    if (SMGC_SUCCESS != lc_bcast(char_buff, buff_size, 0, tier->comm)) {
+        goto out;
+    }
+    elapsed = MPI_Wtime() - elapsed;
+    wd_op_end(wd_op);
+    wd_op = NULL;
+
+    if (0 != tier->rank &&
+        SMGC_SUCCESS != payload_verify(char_buff, buff_size, root_wrank,
+                                       SMGC_PAYLOAD_ANY_RANK, 0)) {
+        goto out;
+    }
+    /* bytes that reached (or left) this rank */
+    in_bw.val = (elapsed > 0.0) ? ((double)buff_size / elapsed /
+                                   (double)SMGC_MB_SIZE) : 0.0;
+    in_bw.rank = my_rank;
+    if (SMGC_SUCCESS != comm_stats(tier->stats_comm, in_bw,
+                                   "broadcast bandwidth", IO_STATS_MBS) ||
+        SMGC_SUCCESS != payload_verify_stats(tier->stats_comm)) {
+        goto out;
+    }
+
+    /* if we are here, then all is well - note that fact */
+    rc = SMGC_SUCCESS;
+out:
+    wd_op_end(wd_op);
+    return rc;
+}
+
+/* ////////////////////////////////////////////////////////////////////////// */
+static int
+root_bcast(void)
+{
+    return run_on_tiers(&root_bcast_tier);
+}
+
+/* ////////////////////////////////////////////////////////////////////////// */
+static int
+rand_root_bcast_tier(smgc_tier_t *tier)
+{
+    int i = 0, buff_size = int_msg_size(), num_itrs = 8, next_bc_root = 0,
+        root_wrank = 0, rc = SMGC_ERROR;
+    char *char_buff = NULL;
+    /* reproducible with --seed */
+    uint64_t state = pass_seed(SMGC_SEED_RAND_ROOT);
+    smgc_wd_op_t *wd_op = NULL;
+
+    if (NULL == (char_buff = (char *)arena_get(buff_size * sizeof(char)))) {
+        return SMGC_ERROR;
+    }
+
+    wd_op = wd_op_begin("rand_root_bcast", 0);
+
+    SMGC_MPF("       message size: %d B\n", buff_size);
+
+    for (i = 0; i < num_itrs; ++i) {
+        /* let the tier's first rank figure out the next "random" root */
+        if (0 == tier->rank) {
+            next_bc_root = (int)(seeded_rand(&state) % (uint64_t)tier->size);
+        }
+        /* let the tier know about the next bcast root */
+        wd_op_step(wd_op, i, tier_wrank(tier, 0), -1);
+        mpi_ret_code = MPI_Bcast(&next_bc_root, 1, MPI_INT, 0, tier->comm);
+        SMGC_MPICHK(mpi_ret_code, out);
+
+        root_wrank = tier_wrank(tier, next_bc_root);
+        SMGC_MPF("       %06d (%s): broadcasting to %s\n", root_wrank,
+                 get_rhn(root_wrank), tier->name);
+
+        if (next_bc_root == tier->rank) {
+            payload_prep(char_buff, buff_size, root_wrank,
+                         SMGC_PAYLOAD_ANY_RANK, i);
+        }
+
+        /* root broadcast! */
+        wd_op_step(wd_op, i, root_wrank, -1);
+        mpi_ret_code = MPI_Bcast(char_buff, buff_size, MPI_CHAR, next_bc_root,
+                                 tier->comm);
+        SMGC_MPICHK(mpi_ret_code, out);
+
+        if (next_bc_root != tier->rank &&
+            SMGC_SUCCESS != payload_verify(char_buff, buff_size, root_wrank,
+                                           SMGC_PAYLOAD_ANY_RANK, i)) {
+            goto out;
+        }
+    }
+    wd_op_end(wd_op);
+    wd_op = NULL;
+    if (SMGC_SUCCESS != payload_verify_stats(tier->stats_comm)) {
+        goto out;
+    }
+    /* success! */
+    rc = SMGC_SUCCESS;
+out:
+    wd_op_end(wd_op);
+    return rc;
+}
+
+/* ////////////////////////////////////////////////////////////////////////// */
+static int
+rand_root_bcast(void)
+{
+    return run_on_tiers(&rand_root_bcast_tier);
+}
+
+/* ////////////////////////////////////////////////////////////////////////// */
+/**
+ * per-root broadcast latency. times SMGC_BCAST_MAP_ITRS broadcasts from every
+ * root of the tier (or a seeded sample of bcast_roots of them) to completion
+ * on all ranks, then reports the distribution over roots and the slowest
+ * roots with their hosts.
+ */
+static int
+bcast_root_map_tier(smgc_tier_t *tier)
+{
+    int i = 0, j = 0, tmp = 0, r = 0, n = 0, n_mine = 0, total = 0;
+    int root = 0, root_wrank = 0, buff_size = int_msg_size(), rc = SMGC_ERROR;
+    int *roots = NULL, *counts = NULL, *displs = NULL;
+    char *char_buff = NULL;
+    double elapsed = 0.0, lat = 0.0;
+    uint64_t state = pass_seed(SMGC_SEED_ROOT_MAP);
+    double_int_t *mine = NULL, *all = NULL;
+    smgc_wd_op_t *wd_op = NULL;
+
+    if (NULL == (char_buff = (char *)arena_get(buff_size * sizeof(char)))) {
+        return SMGC_ERROR;
+    }
+
+    n = (0 == bcast_roots || bcast_roots >= tier->size) ? tier->size :
+                                                          bcast_roots;
+    roots = (int *)malloc(tier->size * sizeof(int));
+    SMGC_MEMCHK(roots, out);
+    mine = (double_int_t *)malloc(n * sizeof(double_int_t));
+    SMGC_MEMCHK(mine, out);
+    /* the first n of a seeded shuffle - the same on every rank */
+    for (i = 0; i < tier->size; ++i) {
+        roots[i] = i;
+    }
+    for (i = 0; i < n && n < tier->size; ++i) {
+        j = i + (int)(seeded_rand(&state) % (uint64_t)(tier->size - i));
+        tmp = roots[i];
+        roots[i] = roots[j];
+        roots[j] = tmp;
+    }
+
+    SMGC_MPF("       message size: %d B, roots: %d of %d, bcasts per root: "
+             "%d\n", buff_size, n, tier->size, SMGC_BCAST_MAP_ITRS);
+
+    wd_op = wd_op_begin("bcast_root_map", 0);
+
+    for (r = 0; r < n; ++r) {
+        root = roots[r];
+        root_wrank = tier_wrank(tier, root);
+        if (root == tier->rank) {
+            payload_prep(char_buff, buff_size, root_wrank,
+                         SMGC_PAYLOAD_ANY_RANK, r);
+        }
+
+        wd_op_step(wd_op, r, root_wrank, -1);
+        mpi_ret_code = MPI_Barrier(tier->comm);
+        SMGC_MPICHK(mpi_ret_code, out);
+        elapsed = MPI_Wtime();
+        for (i = 0; i < SMGC_BCAST_MAP_ITRS; ++i) {
+            mpi_ret_code = MPI_Bcast(char_buff, buff_size, MPI_CHAR, root,
+                                     tier->comm);
+            SMGC_MPICHK(mpi_ret_code, out);
+        }
+        elapsed = MPI_Wtime() - elapsed;
+
+        if (root != tier->rank &&
+            SMGC_SUCCESS != payload_verify(char_buff, buff_size, root_wrank,
+                                           SMGC_PAYLOAD_ANY_RANK, r)) {
+            goto out;
+        }
+        /* a broadcast is done when its last rank is */
+        lat = elapsed / SMGC_BCAST_MAP_ITRS * 1e6;
+        mpi_ret_code = MPI_Reduce(&lat, &mine[r].val, 1, MPI_DOUBLE, MPI_MAX,
+                                  0, tier->comm);
+        SMGC_MPICHK(mpi_ret_code, out);
+        mine[r].rank = root_wrank;
+    }
+    wd_op_end(wd_op);
+    wd_op = NULL;
+
+    /* the master collects the map of every instance of the tier */
+    if (SMGC_MASTER_RANK == my_rank) {
+        counts = (int *)calloc(2 * num_ranks, sizeof(int));
+        SMGC_MEMCHK(counts, out);
+        displs = counts + num_ranks;
+    }
+    n_mine = (0 == tier->rank) ? n : 0;
+    mpi_ret_code = MPI_Gather(&n_mine, 1, MPI_INT, counts, 1, MPI_INT, 0,
+                              tier->stats_comm);
+    SMGC_MPICHK(mpi_ret_code, out);
+    if (SMGC_MASTER_RANK == my_rank) {
+        for (i = 0; i < num_ranks; ++i) {
+            displs[i] = total;
+            total += counts[i];
+        }
+        all = (double_int_t *)malloc(total * sizeof(double_int_t));
+        SMGC_MEMCHK(all, out);
+    }
+    mpi_ret_code = MPI_Gatherv(mine, n_mine, MPI_DOUBLE_INT, all, counts,
+                               displs, MPI_DOUBLE_INT, 0, tier->stats_comm);
+    SMGC_MPICHK(mpi_ret_code, out);
+
+    if (SMGC_MASTER_RANK == my_rank && total > 0) {
+        qsort(all, total, sizeof(double_int_t), &qsort_cmp_dint_desc);
+        SMGC_MPF("   --- per-root latency (slowest rank):\n");
+        SMGC_MPF("          min: %.3f %s, median: %.3f %s, max: %.3f %s\n",
+                 all[total - 1].val, SMGC_TIME_US_UNIT_STR,
+                 all[total / 2].val, SMGC_TIME_US_UNIT_STR, all[0].val,
+                 SMGC_TIME_US_UNIT_STR);
+        SMGC_MPF("   --- %d slowest roots:\n",
+                 (total < SMGC_BCAST_MAP_WORST) ? total :
+                                                  SMGC_BCAST_MAP_WORST);
+        for (i = 0; i < total && i < SMGC_BCAST_MAP_WORST; ++i) {
+            SMGC_MPF("          %06d (%s): %.3f %s\n", all[i].rank,
+                     get_rhn(all[i].rank), all[i].val, SMGC_TIME_US_UNIT_STR);
+        }
+    }
+    if (SMGC_SUCCESS != payload_verify_stats(tier->stats_comm)) {
+        goto out;
+    }
+
+    rc = SMGC_SUCCESS;
+out:
+    wd_op_end(wd_op);
+    if (NULL != all) free(all);
+    if (NULL != counts) free(counts);
+    if (NULL != mine) free(mine);
+    if (NULL != roots) free(roots);
+    return rc;
+}
+
+/* ////////////////////////////////////////////////////////////////////////// */
+static int
+bcast_root_map(void)
+{
+    return run_on_tiers(&bcast_root_map_tier);
+}
+
+/* ////////////////////////////////////////////////////////////////////////// */
+/**
+ * walks message sizes from sweep_min to sweep_max (growing by sweep_factor),
+ * timing right and left ring exchanges at each size. per-size latency and
+ * bandwidth are reduced across the tier. if alternate is true, each timed
+ * exchange is followed by an untimed 1 B exchange, mimicking
+ * alt_sendrecv_ring.
+ */
+static int
+sendrecv_ring_sweep(smgc_tier_t *tier, bool alternate)
+{
+    int i = 0, step = 0, send_tag = 42, recv_tag = 42, buff_size = 0,
+        r_neighbor = 0, l_neighbor = 0, r_wrank = 0, l_wrank = 0,
+        rc = SMGC_ERROR;
+    char *r_send_buff = NULL, *l_send_buff = NULL, *recv_char_buff = NULL;
+    double start = 0.0, elapsed = 0.0, lat = 0.0;
+    double_int_t in_lat = {0.0, 0}, in_bw = {0.0, 0};
+    smgc_wd_op_t *wd_op = NULL;
+    MPI_Status status;
+
+    r_neighbor = (tier->rank + 1) % tier->size;
+    l_neighbor = (tier->rank + tier->size - 1) % tier->size;
+    r_wrank = tier_wrank(tier, r_neighbor);
+    l_wrank = tier_wrank(tier, l_neighbor);
+
+    /* one send buffer per direction, so each carries its own payload */
+    r_send_buff = (char *)arena_get(sweep_max * sizeof(char));
+    SMGC_MEMCHK(r_send_buff, out);
+    l_send_buff = (char *)arena_get(sweep_max * sizeof(char));
+    SMGC_MEMCHK(l_send_buff, out);
+    recv_char_buff = (char *)arena_get(sweep_max * sizeof(char));
+    SMGC_MEMCHK(recv_char_buff, out);
+
+    SMGC_MPF("       message size sweep: %d B to %d B (x%d)\n", sweep_min,
+             sweep_max, sweep_factor);
+    SMGC_MPF("       warmup/timed exchanges per size: %d/%d\n",
+             SMGC_SWEEP_WARMUP_ITRS, SMGC_SWEEP_NUM_ITRS);
+
+    for (buff_size = sweep_min; buff_size <= sweep_max; ++step) {
+        payload_prep(r_send_buff, buff_size, my_rank, r_wrank, step);
+        payload_prep(l_send_buff, buff_size, my_rank, l_wrank, step);
+
+        mpi_ret_code = MPI_Barrier(tier->comm);
+        SMGC_MPICHK(mpi_ret_code, out);
+
+        wd_op = wd_op_begin(alternate ? "alt_sendrecv_ring" :
+                                        "large_sendrecv_ring", 0);
+        elapsed = 0.0;
+        for (i = 0; i < SMGC_SWEEP_WARMUP_ITRS + SMGC_SWEEP_NUM_ITRS; ++i) {
+            wd_op_step(wd_op, step, l_wrank, r_wrank);
+            start = MPI_Wtime();
+            mpi_ret_code = MPI_Sendrecv(r_send_buff, buff_size, MPI_CHAR,
+                                        r_neighbor, send_tag, recv_char_buff,
+                                        buff_size, MPI_CHAR, l_neighbor,
+                                        recv_tag, tier->comm, &status);
+            SMGC_MPICHK(mpi_ret_code, out);
+            /* only record timed exchanges */
+            if (i >= SMGC_SWEEP_WARMUP_ITRS) {
+                elapsed += MPI_Wtime() - start;
+            }
+            if (SMGC_SUCCESS != payload_verify(recv_char_buff, buff_size,
+                                               l_wrank, my_rank, step)) {
+                goto out;
+            }
+
+            wd_op_step(wd_op, step, r_wrank, l_wrank);
+            start = MPI_Wtime();
+            mpi_ret_code = MPI_Sendrecv(l_send_buff, buff_size, MPI_CHAR,
+                                        l_neighbor, send_tag, recv_char_buff,
+                                        buff_size, MPI_CHAR, r_neighbor,
+                                        recv_tag, tier->comm, &status);
+            SMGC_MPICHK(mpi_ret_code, out);
+            if (i >= SMGC_SWEEP_WARMUP_ITRS) {
+                elapsed += MPI_Wtime() - start;
+            }
+            if (SMGC_SUCCESS != payload_verify(recv_char_buff, buff_size,
+                                               r_wrank, my_rank, step)) {
+                goto out;
+            }
+
+            if (alternate) {
+                wd_op_step(wd_op, step, l_wrank, r_wrank);
+                mpi_ret_code = MPI_Sendrecv(r_send_buff, 1, MPI_CHAR,
+                                            r_neighbor, send_tag,
+                                            recv_char_buff, 1, MPI_CHAR,
+                                            l_neighbor, recv_tag,
+                                            tier->comm, &status);
+                SMGC_MPICHK(mpi_ret_code, out);
+                if (SMGC_SUCCESS != payload_verify(recv_char_buff, 1,
+                                                   l_wrank, my_rank,
+                                                   step)) {
+                    goto out;
+                }
+            }
+        }
+
+        wd_op_end(wd_op);
+        wd_op = NULL;
+
+        /* average time of a single (one direction) exchange */
+        lat = elapsed / (2.0 * SMGC_SWEEP_NUM_ITRS);
+
+        in_lat.val = lat * 1e6;
+        in_lat.rank = my_rank;
+        in_bw.val = (lat > 0.0) ?
+                    ((double)buff_size / lat / (double)SMGC_MB_SIZE) : 0.0;
+        in_bw.rank = my_rank;
+
+        SMGC_MPF("   --- message size: %d B\n", buff_size);
+        if (SMGC_SUCCESS != comm_stats(tier->stats_comm, in_lat, "latency",
+                                       IO_STATS_TIME_US) ||
+            SMGC_SUCCESS != comm_stats(tier->stats_comm, in_bw, "bandwidth",
+                                       IO_STATS_MBS)) {
+            goto out;
+        }
+
+        /* grow the message size - watching out for overflow */
+        if (buff_size > sweep_max / sweep_factor) {
+            break;
+        }
+        buff_size *= sweep_factor;
+    }
+
+    if (SMGC_SUCCESS != payload_verify_stats(tier->stats_comm)) {
+        goto out;
+    }
+
+    rc = SMGC_SUCCESS;
+out:
+    wd_op_end(wd_op);
+    return rc;
+}
+
+/* ////////////////////////////////////////////////////////////////////////// */
+static int
+large_sendrecv_ring_tier(smgc_tier_t *tier)
+{
+    int i = 0, num_iters = 4, tag = 42, r_neighbor = 0, l_neighbor = 0,
+        r_wrank = 0, l_wrank = 0;
+    size_t buff_size = msg_size;
+    char *r_send_buff = NULL, *l_send_buff = NULL, *recv_char_buff = NULL;
+    double start = 0.0, elapsed = 0.0;
+    double_int_t in_bw = {0.0, 0};
+    smgc_wd_op_t *wd_op = NULL;
+
+    r_neighbor = (tier->rank + 1) % tier->size;
+    l_neighbor = tier->rank - 1;
+
+    if (l_neighbor < 0) {
+        l_neighbor = tier->size - 1;
+    }
+    r_wrank = tier_wrank(tier, r_neighbor);
+    l_wrank = tier_wrank(tier, l_neighbor);
+
+    if (do_sweep) {
+        return sendrecv_ring_sweep(tier, false);
+    }
+
+    r_send_buff = (char *)arena_get(buff_size * sizeof(char));
+    SMGC_MEMCHK(r_send_buff, error);
+    l_send_buff = (char *)arena_get(buff_size * sizeof(char));
+    SMGC_MEMCHK(l_send_buff, error);
+    recv_char_buff = (char *)arena_get(buff_size * sizeof(char));
+    SMGC_MEMCHK(recv_char_buff, error);
+
+    SMGC_MPF("       message size: %lu B\n", (unsigned long)buff_size);
+
+    wd_op = wd_op_begin("large_sendrecv_ring", 0);
+
+    for (i = 0; i < num_iters; ++i) {
+        payload_prep(r_send_buff, buff_size, my_rank, r_wrank, i);
+        payload_prep(l_send_buff, buff_size, my_rank, l_wrank, i);
+
+        SMGC_MPF("       =====================================>\n");
+
+        wd_op_step(wd_op, i, l_wrank, r_wrank);
+        start = MPI_Wtime();
+        if (SMGC_SUCCESS != lc_sendrecv(r_send_buff, buff_size, r_neighbor,
+                                        recv_char_buff, l_neighbor, tag,
+                                        tier->comm)) {
+            goto error;
+        }
+        elapsed += MPI_Wtime() - start;
+        if (SMGC_SUCCESS != payload_verify(recv_char_buff, buff_size,
+                                           l_wrank, my_rank, i)) {
+            goto error;
+        }
+
+        SMGC_MPF("       <=====================================\n");
+
+        wd_op_step(wd_op, i, r_wrank, l_wrank);
+        start = MPI_Wtime();
+        if (SMGC_SUCCESS != lc_sendrecv(l_send_buff, buff_size, l_neighbor,
+                                        recv_char_buff, r_neighbor, tag,
+                                        tier->comm)) {
+            goto error;
+        }
+        elapsed += MPI_Wtime() - start;
+        if (SMGC_SUCCESS != payload_verify(recv_char_buff, buff_size,
+                                           r_wrank, my_rank, i)) {
+            goto error;
+        }
+    }
+    wd_op_end(wd_op);
+    wd_op = NULL;
+
+    /* bytes received by this rank */
+    in_bw.val = (elapsed > 0.0) ? (2.0 * num_iters * (double)buff_size /
+                                   elapsed / (double)SMGC_MB_SIZE) : 0.0;
+    in_bw.rank = my_rank;
+    if (SMGC_SUCCESS != comm_stats(tier->stats_comm, in_bw,
+                                   "exchange bandwidth", IO_STATS_MBS) ||
+        SMGC_SUCCESS != payload_verify_stats(tier->stats_comm)) {
+        goto error;
+    }
+
+    return SMGC_SUCCESS;
+error:
+    wd_op_end(wd_op);
+    return SMGC_ERROR;
+}
+
+/* ////////////////////////////////////////////////////////////////////////// */
+static int
+large_sendrecv_ring(void)
+{
+    return run_on_tiers(&large_sendrecv_ring_tier);
+}
+
+/* ////////////////////////////////////////////////////////////////////////// */
+static int
+alt_sendrecv_ring_tier(smgc_tier_t *tier)
+{
+    int i = 0, num_iters = 4, tag = 42, r_neighbor = 0, l_neighbor = 0,
+        r_wrank = 0, l_wrank = 0;
+    size_t buff_size = 0, large_buff_size = msg_size, small_buff_size = 1;
+    char *r_send_buff = NULL, *l_send_buff = NULL, *recv_char_buff = NULL;
+    char *large_msg_size_str = "=====================================";
+    char *small_msg_size_str = "-------------------------------------";
+    char *cur_size_str_ptr = large_msg_size_str;
+    smgc_wd_op_t *wd_op = NULL;
+
+    r_neighbor = (tier->rank + 1) % tier->size;
+    l_neighbor = tier->rank - 1;
+
+    if (l_neighbor < 0) {
+        l_neighbor = tier->size - 1;
+    }
+    r_wrank = tier_wrank(tier, r_neighbor);
+    l_wrank = tier_wrank(tier, l_neighbor);
+
+    if (do_sweep) {
+        return sendrecv_ring_sweep(tier, true);
+    }
+
+    /* large enough for both message sizes */
+    r_send_buff = (char *)arena_get(large_buff_size * sizeof(char));
+    SMGC_MEMCHK(r_send_buff, error);
+    l_send_buff = (char *)arena_get(large_buff_size * sizeof(char));
+    SMGC_MEMCHK(l_send_buff, error);
+    recv_char_buff = (char *)arena_get(large_buff_size * sizeof(char));
+    SMGC_MEMCHK(recv_char_buff, error);
+
+    SMGC_MPF("       message size key: === %lu B, --- %lu B\n",
+             (unsigned long)large_buff_size, (unsigned long)small_buff_size);
+
+    wd_op = wd_op_begin("alt_sendrecv_ring", 0);
+
+    for (i = 0; i < num_iters; ++i) {
+        /* what size buffs are we using this time around? */
+        if (0 != i % 2) {
+            buff_size = large_buff_size;
+            cur_size_str_ptr = large_msg_size_str;
+        }
+        else {
+            buff_size = small_buff_size;
+            cur_size_str_ptr = small_msg_size_str;
+        }
+
+        payload_prep(r_send_buff, buff_size, my_rank, r_wrank, i);
+        payload_prep(l_send_buff, buff_size, my_rank, l_wrank, i);
+
+        SMGC_MPF("       %s>\n", cur_size_str_ptr);
+
+        wd_op_step(wd_op, i, l_wrank, r_wrank);
+        if (SMGC_SUCCESS != lc_sendrecv(r_send_buff, buff_size, r_neighbor,
+                                        recv_char_buff, l_neighbor, tag,
+                                        tier->comm)) {
+            goto error;
+        }
+        if (SMGC_SUCCESS != payload_verify(recv_char_buff, buff_size,
+                                           l_wrank, my_rank, i)) {
+            goto error;
+        }
+
+        SMGC_MPF("       <%s\n", cur_size_str_ptr);
+
+        wd_op_step(wd_op, i, r_wrank, l_wrank);
+        if (SMGC_SUCCESS != lc_sendrecv(l_send_buff, buff_size, l_neighbor,
+                                        recv_char_buff, r_neighbor, tag,
+                                        tier->comm)) {
+            goto error;
+        }
+        if (SMGC_SUCCESS != payload_verify(recv_char_buff, buff_size,
+                                           r_wrank, my_rank, i)) {
+            goto error;
+        }
+    }
+    wd_op_end(wd_op);
+    wd_op = NULL;
+    if (SMGC_SUCCESS != payload_verify_stats(tier->stats_comm)) {
+        goto error;
+    }
+
+    return SMGC_SUCCESS;
+error:
+    wd_op_end(wd_op);
+    return SMGC_ERROR;
+}
+
+/* ////////////////////////////////////////////////////////////////////////// */
+static int
+alt_sendrecv_ring(void)
+{
+    return run_on_tiers(&alt_sendrecv_ring_tier);
+}
+
+/* ////////////////////////////////////////////////////////////////////////// */
+/**
+ * average time (s) of one right shift of a size B message around the tier
+ * ring using variant var. *t is set to a negative value if the mpi library
+ * does not provide the variant.
+ */
+static int
+pring_time(int var, smgc_tier_t *tier, char *sbuf, char *rbuf, int size,
+           double *t)
+{
+    int i = 0, tag = 42, num_reqs = 0, rc = SMGC_ERROR;
+    int r_neighbor = (tier->rank + 1) % tier->size,
+        l_neighbor = (tier->rank + tier->size - 1) % tier->size;
+    double start = 0.0;
+    MPI_Request reqs[2] = {MPI_REQUEST_NULL, MPI_REQUEST_NULL};
+#if MPI_VERSION >= 4
+    int p = 0;
+    int parts = (size >= SMGC_PRING_PARTITIONS) ? SMGC_PRING_PARTITIONS : 1;
+    MPI_Comm ring_comm = MPI_COMM_NULL;
+#endif
+
+    *t = -1.0;
+
+    /* one-time setup - the whole point of the persistent variants */
+    switch (var) {
+        case SMGC_PRING_SENDRECV:
+            break;
+        case SMGC_PRING_PERSIST:
+            mpi_ret_code = MPI_Recv_init(rbuf, size, MPI_CHAR, l_neighbor, tag,
+                                         tier->comm, &reqs[0]);
+            SMGC_MPICHK(mpi_ret_code, out);
+            mpi_ret_code = MPI_Send_init(sbuf, size, MPI_CHAR, r_neighbor, tag,
+                                         tier->comm, &reqs[1]);
+            SMGC_MPICHK(mpi_ret_code, out);
+            num_reqs = 2;
+            break;
+        case SMGC_PRING_PCOLL:
+#if MPI_VERSION >= 4
+            /* the ring as a graph: receive from the left, send to the right */
+            mpi_ret_code = MPI_Dist_graph_create_adjacent(
+                               tier->comm, 1, &l_neighbor, MPI_UNWEIGHTED,
+                               1, &r_neighbor, MPI_UNWEIGHTED, MPI_INFO_NULL,
+                               0, &ring_comm);
+            SMGC_MPICHK(mpi_ret_code, out);
+            mpi_ret_code = MPI_Neighbor_alltoall_init(sbuf, size, MPI_CHAR,
+                                                      rbuf, size, MPI_CHAR,
+                                                      ring_comm, MPI_INFO_NULL,
+                                                      &reqs[0]);
+            SMGC_MPICHK(mpi_ret_code, out);
+            num_reqs = 1;
+            break;
+#else
+            return SMGC_SUCCESS;
+#endif
+        case SMGC_PRING_PART:
+#if MPI_VERSION >= 4
+            mpi_ret_code = MPI_Precv_init(rbuf, parts, size / parts, MPI_CHAR,
+                                          l_neighbor, tag, tier->comm,
+                                          MPI_INFO_NULL, &reqs[0]);
+            SMGC_MPICHK(mpi_ret_code, out);
+            mpi_ret_code = MPI_Psend_init(sbuf, parts, size / parts, MPI_CHAR,
+                                          r_neighbor, tag, tier->comm,
+                                          MPI_INFO_NULL, &reqs[1]);
+            SMGC_MPICHK(mpi_ret_code, out);
+            num_reqs = 2;
+            break;
+#else
+            return SMGC_SUCCESS;
+#endif
+        default:
+            SMGC_ERR_MSG("pring_time::unknown variant %d\n", var);
+            goto out;
+    }
+
+    mpi_ret_code = MPI_Barrier(tier->comm);
+    SMGC_MPICHK(mpi_ret_code, out);
+
+    start = MPI_Wtime();
+    for (i = 0; i < SMGC_PRING_NUM_ITRS; ++i) {
+        if (SMGC_PRING_SENDRECV == var) {
+            mpi_ret_code = MPI_Sendrecv(sbuf, size, MPI_CHAR, r_neighbor, tag,
+                                        rbuf, size, MPI_CHAR, l_neighbor, tag,
+                                        tier->comm, MPI_STATUS_IGNORE);
+            SMGC_MPICHK(mpi_ret_code, out);
+            continue;
+        }
+        mpi_ret_code = MPI_Startall(num_reqs, reqs);
+        SMGC_MPICHK(mpi_ret_code, out);
+#if MPI_VERSION >= 4
+        /* mark partitions ready one by one, as a producer would */
+        for (p = 0; SMGC_PRING_PART == var && p < parts; ++p) {
+            mpi_ret_code = MPI_Pready(p, reqs[1]);
+            SMGC_MPICHK(mpi_ret_code, out);
+        }
+#endif
+        mpi_ret_code = MPI_Waitall(num_reqs, reqs, MPI_STATUSES_IGNORE);
+        SMGC_MPICHK(mpi_ret_code, out);
+    }
+    *t = (MPI_Wtime() - start) / SMGC_PRING_NUM_ITRS;
+
+    rc = SMGC_SUCCESS;
+out:
+    for (i = 0; i < num_reqs; ++i) {
+        if (MPI_REQUEST_NULL != reqs[i]) {
+            MPI_Request_free(&reqs[i]);
+        }
+    }
+#if MPI_VERSION >= 4
+    if (MPI_COMM_NULL != ring_comm) {
+        MPI_Comm_free(&ring_comm);
+    }
+#endif
+    return rc;
+}
+
+/* ////////////////////////////////////////////////////////////////////////// */
+/**
+ * prints min/ave/max of t (s) over tier->stats_comm. *base is the average of
+ * the classic variant (set by it on the master) and is used to show what
+ * switching apis buys.
+ */
+static int
+pring_time_stats(smgc_tier_t *tier, int var, double t, double *base)
+{
+    double_int_t in = {t * 1e6, my_rank}, max = {0.0, 0};
+    double min = 0.0, ave = 0.0;
+    int stats_size = 0;
+
+    if (t < 0.0) {
+        SMGC_MPF("       %-16s not supported by this mpi library "
+                 "(MPI %d.%d)\n", pring_names[var], MPI_VERSION,
+                 MPI_SUBVERSION);
+        return SMGC_SUCCESS;
+    }
+
+    mpi_ret_code = MPI_Comm_size(tier->stats_comm, &stats_size);
+    SMGC_MPICHK(mpi_ret_code, err);
+    mpi_ret_code = MPI_Reduce(&in, &max, 1, MPI_DOUBLE_INT, MPI_MAXLOC,
+                              0, tier->stats_comm);
+    SMGC_MPICHK(mpi_ret_code, err);
+    mpi_ret_code = MPI_Reduce(&in.val, &min, 1, MPI_DOUBLE, MPI_MIN,
+                              0, tier->stats_comm);
+    SMGC_MPICHK(mpi_ret_code, err);
+    mpi_ret_code = MPI_Reduce(&in.val, &ave, 1, MPI_DOUBLE, MPI_SUM,
+                              0, tier->stats_comm);
+    SMGC_MPICHK(mpi_ret_code, err);
+    ave /= stats_size;
+
+    if (SMGC_PRING_SENDRECV == var) {
+        *base = ave;
+    }
+    SMGC_MPF("       %-16s %12.3f %12.3f %12.3f %8.2fx  %06d (%s)\n",
+             pring_names[var], min, ave, max.val,
+             (ave > 0.0) ? *base / ave : 0.0, max.rank, get_rhn(max.rank));
+    return SMGC_SUCCESS;
+err:
+    return SMGC_ERROR;
+}
+
+/* ////////////////////////////////////////////////////////////////////////// */
+/**
+ * large_sendrecv_ring pays for message setup on every shift. this times the
+ * same ring built on persistent requests and, where the library provides
+ * them (mpi 4), a persistent neighborhood collective and partitioned
+ * send/recv, and reports their per-shift latency next to the classic
+ * sendrecv.
+ */
+static int
+persistent_ring_tier(smgc_tier_t *tier)
+{
+    int var = 0, size = int_msg_size(), r_wrank = 0, l_wrank = 0;
+    char *sbuf = NULL, *rbuf = NULL;
+    double t = 0.0, base = 0.0;
+    smgc_wd_op_t *wd_op = NULL;
+
+    r_wrank = tier_wrank(tier, (tier->rank + 1) % tier->size);
+    l_wrank = tier_wrank(tier, (tier->rank + tier->size - 1) % tier->size);
+
+    /* partitioned messages are split evenly */
+    if (size >= SMGC_PRING_PARTITIONS) {
+        size -= size % SMGC_PRING_PARTITIONS;
+    }
+
+    sbuf = (char *)arena_get(size * sizeof(char));
+    SMGC_MEMCHK(sbuf, error);
+    rbuf = (char *)arena_get(size * sizeof(char));
+    SMGC_MEMCHK(rbuf, error);
+
+    SMGC_MPF("       message size: %d B, ring shifts per variant: %d\n", size,
+             SMGC_PRING_NUM_ITRS);
+    SMGC_MPF("       %-16s %12s %12s %12s %9s  %s\n", "variant",
+             "min (us)", "ave (us)", "max (us)", "speedup", "max rank");
+
+    wd_op = wd_op_begin("persistent_ring", 0);
+
+    for (var = 0; var < SMGC_NUM_PRING; ++var) {
+        payload_prep(sbuf, size, my_rank, r_wrank, var);
+        wd_op_step(wd_op, var, l_wrank, r_wrank);
+        if (SMGC_SUCCESS != pring_time(var, tier, sbuf, rbuf, size, &t)) {
+            goto error;
+        }
+        if (t >= 0.0 &&
+            SMGC_SUCCESS != payload_verify(rbuf, size, l_wrank, my_rank,
+                                           var)) {
+            goto error;
+        }
+        if (SMGC_SUCCESS != pring_time_stats(tier, var, t, &base)) {
+            goto error;
+        }
+    }
+    wd_op_end(wd_op);
+    wd_op = NULL;
+    if (SMGC_SUCCESS != payload_verify_stats(tier->stats_comm)) {
+        goto error;
+    }
+
+    return SMGC_SUCCESS;
+error:
+    wd_op_end(wd_op);
+    return SMGC_ERROR;
+}
+
+/* ////////////////////////////////////////////////////////////////////////// */
+static int
+persistent_ring(void)
+{
+    return run_on_tiers(&persistent_ring_tier);
+}
+
+/* ////////////////////////////////////////////////////////////////////////// */
+static int
+small_all_to_all_ptp_tier(smgc_tier_t *tier)
+{
+    int i                = 0;
+    int rc               = SMGC_ERROR;
+    int l_neighbor       = 0;
+    int r_neighbor       = 0;
+    int l_wrank          = 0;
+    int r_wrank          = 0;
+    int buff_size        = 1;
+    int n                = tier->size;
+    char *send_char_buff = NULL;
+    char *recv_char_buff = NULL;
+    char *del            = "\b\b\b\b\b\b\b\b\b\b\b\b\b";
+    double start         = 0.0;
+    link_lat_t *my_top   = NULL;
+    smgc_wd_op_t *wd_op  = NULL;
+    smgc_sched_t sched;
+    MPI_Status status;
+
+    if (SMGC_SUCCESS != sched_init(&sched, a2a_sched, n)) {
+        return SMGC_ERROR;
+    }
+
+    send_char_buff = (char *)arena_get(buff_size * sizeof(char));
+    SMGC_MEMCHK(send_char_buff, out);
+    recv_char_buff = (char *)arena_get(buff_size * sizeof(char));
+    SMGC_MEMCHK(recv_char_buff, out);
+    /* this rank's slowest links - start out empty */
+    my_top = (link_lat_t *)malloc(top_k_links * sizeof(link_lat_t));
+    SMGC_MEMCHK(my_top, out);
+    for (i = 0; i < top_k_links; ++i) {
+        my_top[i].lat = -1.0;
+        my_top[i].src = -1;
+        my_top[i].dst = -1;
+    }
+
+    SMGC_MPF("       message size: %d B\n", buff_size);
+    sched_print(&sched);
+    SMGC_MPF("       %s: all to all - ", tier->name);
+
+    wd_op = wd_op_begin("small_all_to_all_ptp", 0);
+
+    for (i = 1; i <= n; ++i) {
+        SMGC_MPF("%s%06d/%06d%s", 1 == i ? "" : del, i, n,
+                 n == i ? "\n" : "");
+
+        r_neighbor = sched_peer(&sched, tier->rank, i, false);
+        l_neighbor = sched_peer(&sched, tier->rank, i, true);
+        r_wrank = tier_wrank(tier, r_neighbor);
+        l_wrank = tier_wrank(tier, l_neighbor);
+
+        payload_prep(send_char_buff, buff_size, my_rank, r_wrank, i);
+
+        wd_op_step(wd_op, i, l_wrank, r_wrank);
+        start = MPI_Wtime();
+        mpi_ret_code = MPI_Sendrecv(send_char_buff, buff_size, MPI_CHAR,
+                                    r_neighbor, i, recv_char_buff, buff_size,
+                                    MPI_CHAR, l_neighbor, i, tier->comm,
+                                    &status);
+        SMGC_MPICHK(mpi_ret_code, out);
+        /* the exchange completes once l_neighbor's message has arrived */
+        top_links_insert(my_top, top_k_links, MPI_Wtime() - start, l_wrank,
+                         my_rank);
+
+        if (SMGC_SUCCESS != payload_verify(recv_char_buff, buff_size,
+                                           l_wrank, my_rank, i)) {
+            goto out;
+        }
+    }
+
+    wd_op_end(wd_op);
+    wd_op = NULL;
+
+    if (SMGC_SUCCESS != top_links_report(tier->stats_comm, my_top,
+                                         top_k_links) ||
+        SMGC_SUCCESS != payload_verify_stats(tier->stats_comm)) {
+        goto out;
+    }
+
+    /* all is well */
+    rc = SMGC_SUCCESS;
+
+out:
+    wd_op_end(wd_op);
+    sched_fini(&sched);
+    if (NULL != my_top) free(my_top);
+    return rc;
+}
+
+/* ////////////////////////////////////////////////////////////////////////// */
+static int
+small_all_to_all_ptp(void)
+{
+    return run_on_tiers(&small_all_to_all_ptp_tier);
+}
+
+/* ////////////////////////////////////////////////////////////////////////// */
+/**
+ * windowed all to all point-to-point. at step i (1 <= i <= n) every rank
+ * sends to and receives from its peers in the a2a_sched schedule, so every
+ * pair in the tier is exercised. up to a window of steps (see: window_msgs)
+ * is kept in flight at once instead of serializing the whole tier behind each
+ * step.
+ */
+static int
+large_all_to_all_ptp_tier(smgc_tier_t *tier)
+{
+    int i                = 0;
+    int slot             = 0;
+    int window           = 0;
+    int tag              = 42;
+    int rc               = SMGC_ERROR;
+    int l_neighbor       = 0;
+    int r_neighbor       = 0;
+    int n                = tier->size;
+    size_t buff_size     = msg_size;
+    char *send_char_buff = NULL;
+    char *recv_char_buff = NULL;
+    char *del            = "\b\b\b\b\b\b\b\b\b\b\b\b\b";
+    int *slot_src        = NULL;
+    double start         = 0.0;
+    double elapsed       = 0.0;
+    double verify_start  = 0.0;
+    double_int_t in_bw   = {0.0, 0};
+    double_int_t in_time = {0.0, 0};
+    MPI_Request *reqs    = NULL;
+    smgc_wd_op_t *wd_op  = NULL;
+    smgc_sched_t sched;
+
+    if (SMGC_SUCCESS != sched_init(&sched, a2a_sched, n)) {
+        return SMGC_ERROR;
+    }
+
+    /* no point in having more exchanges in flight than there are steps */
+    window = window_msgs(buff_size);
+    if (window > n) window = n;
+
+    send_char_buff = (char *)arena_get(buff_size * sizeof(char));
+    SMGC_MEMCHK(send_char_buff, out);
+    /* one receive buffer per in-flight exchange */
+    recv_char_buff = (char *)arena_get((size_t)window * buff_size);
+    SMGC_MEMCHK(recv_char_buff, out);
+    reqs = (MPI_Request *)malloc(2 * window * sizeof(MPI_Request));
+    SMGC_MEMCHK(reqs, out);
+    /* world rank of the source of the message in flight in each slot */
+    slot_src = (int *)malloc(window * sizeof(int));
+    SMGC_MEMCHK(slot_src, out);
+    for (i = 0; i < 2 * window; ++i) {
+        reqs[i] = MPI_REQUEST_NULL;
+    }
+    for (i = 0; i < window; ++i) {
+        slot_src[i] = -1;
+    }
+
+    /* one send buffer serves every destination */
+    payload_prep(send_char_buff, buff_size, my_rank, SMGC_PAYLOAD_ANY_RANK, 0);
+
+    SMGC_MPF("       message size: %lu B\n", (unsigned long)buff_size);
+    SMGC_MPF("       exchange window: %d\n", window);
+    sched_print(&sched);
+    SMGC_MPF("       %s: all to all - ", tier->name);
+
+    mpi_ret_code = MPI_Barrier(tier->comm);
+    SMGC_MPICHK(mpi_ret_code, out);
+
+    wd_op = wd_op_begin("large_all_to_all_ptp", 0);
+
+    verify_start = verify_time;
+    start = MPI_Wtime();
+    for (i = 1; i <= n; ++i) {
+        SMGC_MPF("%s%06d/%06d%s", 1 == i ? "" : del, i, n,
+                 n == i ? "\n" : "");
+
+        slot = (i - 1) % window;
+        /* retire the exchange that previously occupied this slot */
+        if (slot_src[slot] >= 0) {
+            wd_op_step(wd_op, i - window, slot_src[slot],
+                       tier_wrank(tier, sched_peer(&sched, tier->rank,
+                                                   i - window, false)));
+        }
+        mpi_ret_code = MPI_Waitall(2, &reqs[2 * slot], MPI_STATUSES_IGNORE);
+        SMGC_MPICHK(mpi_ret_code, out);
+        if (slot_src[slot] >= 0 &&
+            SMGC_SUCCESS != payload_verify(recv_char_buff +
+                                           (size_t)slot * buff_size,
+                                           buff_size, slot_src[slot],
+                                           SMGC_PAYLOAD_ANY_RANK, 0)) {
+            goto out;
+        }
+
+        r_neighbor = sched_peer(&sched, tier->rank, i, false);
+        l_neighbor = sched_peer(&sched, tier->rank, i, true);
+
+        /* sources are unique within a pass, so a single tag suffices */
+        if (SMGC_SUCCESS != lc_irecv(recv_char_buff + (size_t)slot * buff_size,
+                                     buff_size, l_neighbor, tag, tier->comm,
+                                     &reqs[2 * slot])) {
+            goto out;
+        }
+        slot_src[slot] = tier_wrank(tier, l_neighbor);
+        if (SMGC_SUCCESS != lc_isend(send_char_buff, buff_size, r_neighbor,
+                                     tag, tier->comm, &reqs[2 * slot + 1])) {
+            goto out;
+        }
+    }
+    wd_op_step(wd_op, n, -1, -1);
+    mpi_ret_code = MPI_Waitall(2 * window, reqs, MPI_STATUSES_IGNORE);
+    SMGC_MPICHK(mpi_ret_code, out);
+    wd_op_end(wd_op);
+    wd_op = NULL;
+    /* keep verification out of the exchange time */
+    elapsed = (MPI_Wtime() - start) - (verify_time - verify_start);
+
+    for (slot = 0; slot < window; ++slot) {
+        if (slot_src[slot] >= 0 &&
+            SMGC_SUCCESS != payload_verify(recv_char_buff +
+                                           (size_t)slot * buff_size,
+                                           buff_size, slot_src[slot],
+                                           SMGC_PAYLOAD_ANY_RANK, 0)) {
+            goto out;
+        }
+    }
+
+    /* bytes both sent and received by this rank */
+    in_bw.val = (elapsed > 0.0) ? (2.0 * (double)n * buff_size /
+                                   elapsed / (double)SMGC_MB_SIZE) : 0.0;
+    in_bw.rank = my_rank;
+    in_time.val = elapsed;
+    in_time.rank = my_rank;
+
+    if (SMGC_SUCCESS != comm_stats(tier->stats_comm, in_time, "exchange time",
+                                   IO_STATS_TIME_S) ||
+        SMGC_SUCCESS != comm_stats(tier->stats_comm, in_bw,
+                                   "exchange bandwidth", IO_STATS_MBS) ||
+        SMGC_SUCCESS != payload_verify_stats(tier->stats_comm)) {
+        goto out;
+    }
+
+    /* all is well */
+    rc = SMGC_SUCCESS;
+
+out:
+    wd_op_end(wd_op);
+    sched_fini(&sched);
+    if (NULL != reqs) free(reqs);
+    if (NULL != slot_src) free(slot_src);
+    return rc;
+}
+
+/* ////////////////////////////////////////////////////////////////////////// */
+static int
+large_all_to_all_ptp(void)
+{
+    return run_on_tiers(&large_all_to_all_ptp_tier);
+}
+
+/* ////////////////////////////////////////////////////////////////////////// */
+/**
+ * loads the whole fabric at once: ranks are paired up by a random perfect
+ * matching and every pair streams SMGC_BISECT_NUM_MSGS messages of msg_size
+ * in both directions at the same time. repeated over SMGC_BISECT_MATCHINGS
+ * matchings. per-pair bandwidth is reported per rank; bisection bandwidth is
+ * all bytes moved by a matching over its slowest pair's time.
+ */
+static int
+bisection_bw(void)
+{
+    int i = 0, m = 0, k = 0, slot = 0, window = 0, partner = -1, peer = -1;
+    int tag = 42, num_active = 0, buff_size = int_msg_size(), rc = SMGC_ERROR;
+    int *perm = NULL;
+    char *send_char_buff = NULL, *recv_char_buff = NULL;
+    double start = 0.0, elapsed = 0.0, verify_start = 0.0, bytes = 0.0;
+    double bw_sum = 0.0, bisect_bw = 0.0, bisect_min = 0.0, bisect_sum = 0.0;
+    /* [0]: bytes received [1]: exchange time */
+    double in_red[2] = {0.0, 0.0}, out_red[2] = {0.0, 0.0};
+    double_int_t in_bw = {0.0, 0}, slowest = {0.0, 0};
+    MPI_Request *reqs = NULL;
+    smgc_wd_op_t *wd_op = NULL;
+
+    if (num_ranks < 2) {
+        SMGC_MPF("       at least 2 ranks are required - skipping\n");
+        return SMGC_SUCCESS;
+    }
+
+    window = window_msgs(buff_size);
+    if (window > SMGC_BISECT_NUM_MSGS) window = SMGC_BISECT_NUM_MSGS;
+
+    perm = (int *)malloc(num_ranks * sizeof(int));
+    SMGC_MEMCHK(perm, out);
+    send_char_buff = (char *)arena_get(buff_size * sizeof(char));
+    SMGC_MEMCHK(send_char_buff, out);
+    /* one receive buffer per in-flight message */
+    recv_char_buff = (char *)arena_get((size_t)window * buff_size);
+    SMGC_MEMCHK(recv_char_buff, out);
+    reqs = (MPI_Request *)malloc(2 * window * sizeof(MPI_Request));
+    SMGC_MEMCHK(reqs, out);
+    for (i = 0; i < 2 * window; ++i) {
+        reqs[i] = MPI_REQUEST_NULL;
+    }
+
+    SMGC_MPF("       message size: %d B\n", buff_size);
+    SMGC_MPF("       matchings: %d, messages per direction: %d, window: %d\n",
+             SMGC_BISECT_MATCHINGS, SMGC_BISECT_NUM_MSGS, window);
+    SMGC_MPF("       seed: %lu\n", rng_seed);
+
+    wd_op = wd_op_begin("bisection_bw", 0);
+
+    for (m = 0; m < SMGC_BISECT_MATCHINGS; ++m) {
+        draw_matching(perm, num_ranks, m);
+        partner = matching_partner(perm, num_ranks, my_rank);
+        if (partner >= 0) {
+            payload_prep(send_char_buff, buff_size, my_rank, partner, m);
+        }
+
+        mpi_ret_code = MPI_Barrier(MPI_COMM_WORLD);
+        SMGC_MPICHK(mpi_ret_code, out);
+
+        verify_start = verify_time;
+        start = MPI_Wtime();
+        for (k = 0; k < SMGC_BISECT_NUM_MSGS && partner >= 0; ++k) {
+            slot = k % window;
+            /* retire the message that previously occupied this slot */
+            if (k >= window) {
+                wd_op_step(wd_op, m, partner, partner);
+                mpi_ret_code = MPI_Waitall(2, &reqs[2 * slot],
+                                           MPI_STATUSES_IGNORE);
+                SMGC_MPICHK(mpi_ret_code, out);
+                if (SMGC_SUCCESS != payload_verify(recv_char_buff +
+                                                   (size_t)slot * buff_size,
+                                                   buff_size, partner,
+                                                   my_rank, m)) {
+                    goto out;
+                }
+            }
+            mpi_ret_code = MPI_Irecv(recv_char_buff + (size_t)slot * buff_size,
+                                     buff_size, MPI_CHAR, partner, tag,
+                                     MPI_COMM_WORLD, &reqs[2 * slot]);
+            SMGC_MPICHK(mpi_ret_code, out);
+            mpi_ret_code = MPI_Isend(send_char_buff, buff_size, MPI_CHAR,
+                                     partner, tag, MPI_COMM_WORLD,
+                                     &reqs[2 * slot + 1]);
+            SMGC_MPICHK(mpi_ret_code, out);
+        }
+        wd_op_step(wd_op, m, partner, partner);
+        mpi_ret_code = MPI_Waitall(2 * window, reqs, MPI_STATUSES_IGNORE);
+        SMGC_MPICHK(mpi_ret_code, out);
+        /* keep verification out of the exchange time */
+        elapsed = (MPI_Wtime() - start) - (verify_time - verify_start);
+        for (slot = 0; slot < window && partner >= 0; ++slot) {
+            if (SMGC_SUCCESS != payload_verify(recv_char_buff +
+                                               (size_t)slot * buff_size,
+                                               buff_size, partner, my_rank,
+                                               m)) {
+                goto out;
+            }
+        }
+
+        bytes = (partner >= 0) ?
+                (double)SMGC_BISECT_NUM_MSGS * (double)buff_size : 0.0;
+        in_bw.rank = my_rank;
+        /* the rank sitting out can't be the slowest */
+        in_bw.val = DBL_MAX;
+        if (partner >= 0) {
+            in_bw.val = (elapsed > 0.0) ?
+                        (bytes / elapsed / (double)SMGC_MB_SIZE) : 0.0;
+            bw_sum += in_bw.val;
+            ++num_active;
+        }
+        in_red[0] = bytes;
+        in_red[1] = (partner >= 0) ? elapsed : 0.0;
+
+        mpi_ret_code = MPI_Reduce(&in_bw, &slowest, 1, MPI_DOUBLE_INT,
+                                  MPI_MINLOC, SMGC_MASTER_RANK,
+                                  MPI_COMM_WORLD);
+        SMGC_MPICHK(mpi_ret_code, out);
+        mpi_ret_code = MPI_Reduce(&in_red[0], &out_red[0], 1, MPI_DOUBLE,
+                                  MPI_SUM, SMGC_MASTER_RANK, MPI_COMM_WORLD);
+        SMGC_MPICHK(mpi_ret_code, out);
+        mpi_ret_code = MPI_Reduce(&in_red[1], &out_red[1], 1, MPI_DOUBLE,
+                                  MPI_MAX, SMGC_MASTER_RANK, MPI_COMM_WORLD);
+        SMGC_MPICHK(mpi_ret_code, out);
 
-    SMGC_MPF("   --- %s:\n", label);
-    SMGC_MPF("          max rank: %06d (%s)\n", max.rank, get_rhn(max.rank));
-    SMGC_MPF("          max %s: %.3f %s\n", label, max.val, unit);
-    SMGC_MPF("          min rank: %06d (%s)\n", min.rank, get_rhn(min.rank));
-    SMGC_MPF("          min %s: %.3f %s\n", label, min.val, unit);
-    SMGC_MPF("          ave %s: %.3f %s\n", label, sum / num_ranks, unit);
-    SMGC_MPF("          aggregate %s: %.3f %s\n", label, sum, unit);
+        if (SMGC_MASTER_RANK == my_rank) {
+            bisect_bw = (out_red[1] > 0.0) ?
+                        (out_red[0] / out_red[1] / (double)SMGC_MB_SIZE) : 0.0;
+            bisect_min = (0 == m || bisect_bw < bisect_min) ? bisect_bw :
+                                                              bisect_min;
+            bisect_sum += bisect_bw;
+            /* the master has the matching, so it knows the slowest pair */
+            for (i = 0; i < num_ranks; ++i) {
+                if (slowest.rank == perm[i]) {
+                    peer = perm[i ^ 1];
+                    break;
+                }
+            }
+            SMGC_MPF("   --- matching %d: bisection bandwidth: %.3f %s\n", m,
+                     bisect_bw, SMGC_MBS_UNIT_STR);
+            SMGC_MPF("          slowest pair: %06d (%s) <== %06d (%s): "
+                     "%.3f %s\n", slowest.rank, get_rhn(slowest.rank),
+                     peer, get_rhn(peer), slowest.val,
+                     SMGC_MBS_UNIT_STR);
+        }
+    }
+    wd_op_end(wd_op);
+    wd_op = NULL;
+
+    /* per-pair bandwidth, averaged over the matchings this rank was in */
+    in_bw.val = (num_active > 0) ? (bw_sum / num_active) : 0.0;
+    in_bw.rank = my_rank;
+    if (SMGC_SUCCESS != io_stats(in_bw, "pair bandwidth", IO_STATS_MBS)) {
+        goto out;
+    }
+    SMGC_MPF("   --- bisection bandwidth:\n");
+    SMGC_MPF("          min bisection bandwidth: %.3f %s\n", bisect_min,
+             SMGC_MBS_UNIT_STR);
+    SMGC_MPF("          ave bisection bandwidth: %.3f %s\n",
+             bisect_sum / SMGC_BISECT_MATCHINGS, SMGC_MBS_UNIT_STR);
+    if (SMGC_SUCCESS != payload_verify_stats(MPI_COMM_WORLD)) {
+        goto out;
+    }
+
+    rc = SMGC_SUCCESS;
+out:
+    wd_op_end(wd_op);
+    if (NULL != reqs) free(reqs);
+    if (NULL != perm) free(perm);
+    return rc;
+}
+
+
+/* ////////////////////////////////////////////////////////////////////////// */
+/**
+ * creates a window exposing size B per rank: allocated by mpi or, if dynamic,
+ * an arena slice attached to a dynamic window. *base is set to the local
+ * memory and disps[r] to the displacement of rank r's memory.
+ */
+static int
+rma_win_open(bool dynamic, int size, char **base, MPI_Aint *disps,
+             MPI_Win *win)
+{
+    int i = 0;
+
+    if (!dynamic) {
+        mpi_ret_code = MPI_Win_allocate((MPI_Aint)size, 1, MPI_INFO_NULL,
+                                        MPI_COMM_WORLD, base, win);
+        SMGC_MPICHK(mpi_ret_code, err);
+        for (i = 0; i < num_ranks; ++i) {
+            disps[i] = 0;
+        }
+        return SMGC_SUCCESS;
+    }
 
+    *base = (char *)arena_get(size);
+    SMGC_MEMCHK(*base, err);
+    mpi_ret_code = MPI_Win_create_dynamic(MPI_INFO_NULL, MPI_COMM_WORLD, win);
+    SMGC_MPICHK(mpi_ret_code, err);
+    mpi_ret_code = MPI_Win_attach(*win, *base, (MPI_Aint)size);
+    SMGC_MPICHK(mpi_ret_code, err);
+    /* dynamic windows are addressed by absolute address */
+    mpi_ret_code = MPI_Get_address(*base, &disps[my_rank]);
+    SMGC_MPICHK(mpi_ret_code, err);
+    mpi_ret_code = MPI_Allgather(MPI_IN_PLACE, 0, MPI_DATATYPE_NULL, disps, 1,
+                                 MPI_AINT, MPI_COMM_WORLD);
+    SMGC_MPICHK(mpi_ret_code, err);
     return SMGC_SUCCESS;
 err:
     return SMGC_ERROR;
 }
 
 /* ////////////////////////////////////////////////////////////////////////// */
+/**
+ * value of word k of the operand rank accumulates in rma_bw case c.
+ */
+static unsigned
+rma_acc_val(int rank, int k, int c)
+{
+    return (unsigned)mix64(((uint64_t)(uint32_t)rank << 32) ^
+                           ((uint64_t)(uint32_t)c << 48) ^ (uint64_t)k);
+}
+
 /* ////////////////////////////////////////////////////////////////////////// */
-/* test functions                                                             */
+/**
+ * verifies that the count words of win_buff, zeroed before rma_bw case c, now
+ * hold origin's operand summed SMGC_RMA_NUM_ITRS times. time spent here is
+ * accumulated in verify_time (see: payload_verify).
+ */
+static int
+rma_acc_verify(const unsigned *win_buff, int count, int origin, int c)
+{
+    int k = 0, rc = SMGC_SUCCESS;
+    double start = 0.0;
+
+    if (!do_verify) {
+        return SMGC_SUCCESS;
+    }
+
+    start = MPI_Wtime();
+    for (k = 0; k < count; ++k) {
+        if (win_buff[k] != SMGC_RMA_NUM_ITRS * rma_acc_val(origin, k, c)) {
+            rc = SMGC_ERROR;
+            break;
+        }
+    }
+    verify_time += MPI_Wtime() - start;
+
+    if (SMGC_SUCCESS != rc) {
+        SMGC_ERR_MSG("accumulate result mismatch on rank %d (%s): operands "
+                     "from rank %d (%s), case %d, first bad word at index "
+                     "%d\n", my_rank, host_name_buff, origin, get_rhn(origin),
+                     c, k);
+    }
+    return rc;
+}
+
 /* ////////////////////////////////////////////////////////////////////////// */
+/**
+ * average time (s) of one access epoch of synchronization mode sync moving
+ * size B between lbuf and target's window memory at disp with operation op
+ * (SMGC_RMA_*). accumulates add unsigned words. origin is the rank that
+ * accesses this rank's window. either may be -1.
+ */
+static int
+rma_xfer_time(MPI_Win win, int sync, int op, int target, int origin,
+              MPI_Aint disp, char *lbuf, int size, double *t)
+{
+    int i = 0, count = size / (int)sizeof(unsigned), rc = SMGC_ERROR;
+    double start = 0.0;
+    MPI_Group world_grp = MPI_GROUP_NULL, target_grp = MPI_GROUP_NULL,
+              origin_grp = MPI_GROUP_NULL;
+
+    if (SMGC_RMA_PSCW == sync) {
+        mpi_ret_code = MPI_Comm_group(MPI_COMM_WORLD, &world_grp);
+        SMGC_MPICHK(mpi_ret_code, out);
+        if (target >= 0) {
+            mpi_ret_code = MPI_Group_incl(world_grp, 1, &target, &target_grp);
+            SMGC_MPICHK(mpi_ret_code, out);
+        }
+        if (origin >= 0) {
+            mpi_ret_code = MPI_Group_incl(world_grp, 1, &origin, &origin_grp);
+            SMGC_MPICHK(mpi_ret_code, out);
+        }
+    }
+
+    mpi_ret_code = MPI_Barrier(MPI_COMM_WORLD);
+    SMGC_MPICHK(mpi_ret_code, out);
+
+    start = MPI_Wtime();
+    if (SMGC_RMA_FENCE == sync) {
+        mpi_ret_code = MPI_Win_fence(MPI_MODE_NOPRECEDE, win);
+        SMGC_MPICHK(mpi_ret_code, out);
+    }
+    for (i = 0; i < SMGC_RMA_NUM_ITRS; ++i) {
+        /* open the epoch */
+        if (SMGC_RMA_PSCW == sync && origin >= 0) {
+            mpi_ret_code = MPI_Win_post(origin_grp, 0, win);
+            SMGC_MPICHK(mpi_ret_code, out);
+        }
+        if (SMGC_RMA_PSCW == sync && target >= 0) {
+            mpi_ret_code = MPI_Win_start(target_grp, 0, win);
+            SMGC_MPICHK(mpi_ret_code, out);
+        }
+        if (SMGC_RMA_LOCK == sync && target >= 0) {
+            mpi_ret_code = MPI_Win_lock(MPI_LOCK_EXCLUSIVE, target, 0, win);
+            SMGC_MPICHK(mpi_ret_code, out);
+        }
+        /* move the data */
+        if (target >= 0) {
+            switch (op) {
+                case SMGC_RMA_GET:
+                    mpi_ret_code = MPI_Get(lbuf, size, MPI_CHAR, target, disp,
+                                           size, MPI_CHAR, win);
+                    break;
+                case SMGC_RMA_ACC:
+                    mpi_ret_code = MPI_Accumulate(lbuf, count, MPI_UNSIGNED,
+                                                  target, disp, count,
+                                                  MPI_UNSIGNED, MPI_SUM, win);
+                    break;
+                default:
+                    mpi_ret_code = MPI_Put(lbuf, size, MPI_CHAR, target, disp,
+                                           size, MPI_CHAR, win);
+                    break;
+            }
+            SMGC_MPICHK(mpi_ret_code, out);
+        }
+        /* and close the epoch */
+        switch (sync) {
+            case SMGC_RMA_FENCE:
+                mpi_ret_code = MPI_Win_fence((SMGC_RMA_NUM_ITRS - 1 == i) ?
+                                             MPI_MODE_NOSUCCEED : 0, win);
+                SMGC_MPICHK(mpi_ret_code, out);
+                break;
+            case SMGC_RMA_PSCW:
+                if (target >= 0) {
+                    mpi_ret_code = MPI_Win_complete(win);
+                    SMGC_MPICHK(mpi_ret_code, out);
+                }
+                if (origin >= 0) {
+                    mpi_ret_code = MPI_Win_wait(win);
+                    SMGC_MPICHK(mpi_ret_code, out);
+                }
+                break;
+            default:
+                if (target >= 0) {
+                    mpi_ret_code = MPI_Win_unlock(target, win);
+                    SMGC_MPICHK(mpi_ret_code, out);
+                }
+                break;
+        }
+    }
+    *t = (MPI_Wtime() - start) / SMGC_RMA_NUM_ITRS;
+
+    rc = SMGC_SUCCESS;
+out:
+    if (MPI_GROUP_NULL != origin_grp) MPI_Group_free(&origin_grp);
+    if (MPI_GROUP_NULL != target_grp) MPI_Group_free(&target_grp);
+    if (MPI_GROUP_NULL != world_grp) MPI_Group_free(&world_grp);
+    return rc;
+}
+
 /* ////////////////////////////////////////////////////////////////////////// */
+/**
+ * prints one row of min/ave/max/aggregate rate over mpi_comm_world and the
+ * slowest rank. a negative rate marks a rank that sat the case out.
+ */
+static int
+rate_row_stats(const char *label, double rate)
+{
+    /* [0]: rate [1]: participant count */
+    double in_sum[2] = {(rate < 0.0) ? 0.0 : rate, (rate < 0.0) ? 0.0 : 1.0};
+    double out_sum[2] = {0.0, 0.0};
+    double_int_t in_min = {(rate < 0.0) ? DBL_MAX : rate, my_rank},
+                 in_max = {rate, my_rank}, min = {0.0, 0}, max = {0.0, 0};
+
+    mpi_ret_code = MPI_Reduce(&in_min, &min, 1, MPI_DOUBLE_INT, MPI_MINLOC,
+                              SMGC_MASTER_RANK, MPI_COMM_WORLD);
+    SMGC_MPICHK(mpi_ret_code, err);
+    mpi_ret_code = MPI_Reduce(&in_max, &max, 1, MPI_DOUBLE_INT, MPI_MAXLOC,
+                              SMGC_MASTER_RANK, MPI_COMM_WORLD);
+    SMGC_MPICHK(mpi_ret_code, err);
+    mpi_ret_code = MPI_Reduce(in_sum, out_sum, 2, MPI_DOUBLE, MPI_SUM,
+                              SMGC_MASTER_RANK, MPI_COMM_WORLD);
+    SMGC_MPICHK(mpi_ret_code, err);
+
+    SMGC_MPF("       %-26s %10.3f %10.3f %10.3f %12.3f  %06d (%s)\n", label,
+             min.val, (out_sum[1] > 0.0) ? out_sum[0] / out_sum[1] : 0.0,
+             max.val, out_sum[0], min.rank, get_rhn(min.rank));
+    return SMGC_SUCCESS;
+err:
+    return SMGC_ERROR;
+}
 
 /* ////////////////////////////////////////////////////////////////////////// */
-/* test by request only */
+/**
+ * one-sided bandwidth. for mpi-allocated and dynamic windows, a ring and a
+ * random matching pattern, and fence, pscw and lock synchronization, times
+ * put, get and accumulate (MPI_SUM) epochs of msg_size B and verifies what
+ * arrived. one row per case with the slowest rank.
+ */
 static int
-n_to_n_io(void)
+rma_bw(void)
 {
-    int i = 0, j = 0, fd = -1, rc = SMGC_ERROR, mpi_rc = MPI_ERR_OTHER;
-    /* what we are going to write and what we should read, buff rest char */
-    char wr_char = 'j', clobber_char = 'x';
-    ssize_t bytes_written = -1, bytes_read = -1;
-    /* the size of the file that i'll be writing (in B) */
-    size_t buff_size = file_size;
-    char *my_file_name = NULL;
-    /* points to buffer used for both reading and writing */
-    char *buff = NULL;
-    /* variables for recording time */
-    double open_time = 0.0, close_time = 0.0, write_start = 0.0,
-           write_fin = 0.0;
-    double read_start = 0.0, read_fin = 0.0, lseek_start = 0.0, lseek_fin = 0.0,
-           effe_bw_time_fix = 0.0, memset_start = 0.0, memset_fin = 0.0,
-           tmp_dbl = 0.0;
-    /* bandwidth variables */
-    double effe_bw = 0.0, read_bw = 0.0, write_bw = 0.0;
-    /* for reduce operations that find max and min rank */
-    double_int_t in_effe = {0.0, 0};
-    double_int_t in_wr = {0.0, 0};
-    double_int_t in_rd = {0.0, 0};
+    int c = 0, kind = 0, pat = 0, sync = 0, op = 0, target = -1, origin = -1;
+    int size = int_msg_size(), rc = SMGC_ERROR, *perm = NULL;
+    int count = size / (int)sizeof(unsigned), k = 0, len = 0;
+    bool dynamic = false, valid = true;
+    char *base = NULL, *lbuf = NULL;
+    char label[64];
+    double t = 0.0, bw = 0.0;
+    MPI_Aint *disps = NULL;
+    MPI_Win win = MPI_WIN_NULL;
+    smgc_wd_op_t *wd_op = NULL;
+
+    if (num_ranks < 2) {
+        SMGC_MPF("       at least 2 ranks are required - skipping\n");
+        return SMGC_SUCCESS;
+    }
+
+    perm = (int *)malloc(num_ranks * sizeof(int));
+    SMGC_MEMCHK(perm, out);
+    disps = (MPI_Aint *)calloc(num_ranks, sizeof(MPI_Aint));
+    SMGC_MEMCHK(disps, out);
+    lbuf = (char *)arena_get(size);
+    SMGC_MEMCHK(lbuf, out);
+
+    SMGC_MPF("       message size: %d B, epochs per case: %d\n", size,
+             SMGC_RMA_NUM_ITRS);
+    SMGC_MPF("       %-26s %10s %10s %10s %12s  %s\n", "case (MB/s)", "min",
+             "ave", "max", "aggregate", "min rank");
+
+    wd_op = wd_op_begin("rma_bw", 0);
+
+    for (c = 0, kind = 0; kind < 2; ++kind) {
+        dynamic = (1 == kind);
+        if (SMGC_SUCCESS != rma_win_open(dynamic, size, &base, disps, &win)) {
+            goto out;
+        }
+        for (pat = 0; pat < 2; ++pat) {
+            if (0 == pat) {
+                target = (my_rank + 1) % num_ranks;
+                origin = (my_rank + num_ranks - 1) % num_ranks;
+            }
+            else {
+                draw_matching(perm, num_ranks, 0);
+                target = origin = matching_partner(perm, num_ranks, my_rank);
+            }
+            for (sync = 0; sync < SMGC_NUM_RMA_SYNCS; ++sync) {
+                for (op = 0; op < SMGC_NUM_RMA_OPS; ++op, ++c) {
+                    /* accumulates move whole unsigned words */
+                    len = (SMGC_RMA_ACC == op) ?
+                          count * (int)sizeof(unsigned) : size;
+                    /* window memory is written locally under a self lock */
+                    mpi_ret_code = MPI_Win_lock(MPI_LOCK_EXCLUSIVE, my_rank, 0,
+                                                win);
+                    SMGC_MPICHK(mpi_ret_code, out);
+                    if (SMGC_RMA_GET == op) {
+                        payload_prep(base, size, my_rank,
+                                     SMGC_PAYLOAD_ANY_RANK, c);
+                    }
+                    else {
+                        memset(base, 0, size);
+                    }
+                    mpi_ret_code = MPI_Win_unlock(my_rank, win);
+                    SMGC_MPICHK(mpi_ret_code, out);
+                    if (SMGC_RMA_PUT == op && target >= 0) {
+                        payload_prep(lbuf, size, my_rank, target, c);
+                    }
+                    for (k = 0; SMGC_RMA_ACC == op && k < count; ++k) {
+                        ((unsigned *)lbuf)[k] = rma_acc_val(my_rank, k, c);
+                    }
+
+                    wd_op_step(wd_op, c, origin, target);
+                    if (SMGC_SUCCESS != rma_xfer_time(win, sync, op,
+                                                      target, origin,
+                                                      target >= 0 ?
+                                                      disps[target] : 0,
+                                                      lbuf, size, &t)) {
+                        goto out;
+                    }
+                    mpi_ret_code = MPI_Barrier(MPI_COMM_WORLD);
+                    SMGC_MPICHK(mpi_ret_code, out);
+
+                    /* check what landed */
+                    if (SMGC_RMA_GET == op && target >= 0) {
+                        valid = (SMGC_SUCCESS ==
+                                 payload_verify(lbuf, size, target,
+                                                SMGC_PAYLOAD_ANY_RANK, c));
+                    }
+                    if (SMGC_RMA_GET != op && origin >= 0) {
+                        mpi_ret_code = MPI_Win_lock(MPI_LOCK_SHARED, my_rank,
+                                                    0, win);
+                        SMGC_MPICHK(mpi_ret_code, out);
+                        valid = (SMGC_SUCCESS ==
+                                 ((SMGC_RMA_ACC == op) ?
+                                  rma_acc_verify((unsigned *)base, count,
+                                                 origin, c) :
+                                  payload_verify(base, size, origin, my_rank,
+                                                 c)));
+                        mpi_ret_code = MPI_Win_unlock(my_rank, win);
+                        SMGC_MPICHK(mpi_ret_code, out);
+                    }
+                    if (!valid) {
+                        goto out;
+                    }
+
+                    snprintf(label, sizeof(label), "%s %s %s %s",
+                             dynamic ? "dynamic" : "allocate",
+                             (0 == pat) ? "ring" : "random",
+                             rma_sync_names[sync], rma_op_names[op]);
+                    bw = (target >= 0) ? ((double)len / t / SMGC_MB_SIZE) :
+                                         -1.0;
+                    if (SMGC_SUCCESS != rate_row_stats(label, bw)) {
+                        goto out;
+                    }
+                }
+            }
+        }
+        if (dynamic) {
+            mpi_ret_code = MPI_Win_detach(win, base);
+            SMGC_MPICHK(mpi_ret_code, out);
+        }
+        mpi_ret_code = MPI_Win_free(&win);
+        SMGC_MPICHK(mpi_ret_code, out);
+    }
+    wd_op_end(wd_op);
+    wd_op = NULL;
+
+    if (SMGC_SUCCESS != payload_verify_stats(MPI_COMM_WORLD)) {
+        goto out;
+    }
+
+    rc = SMGC_SUCCESS;
+out:
+    wd_op_end(wd_op);
+    if (MPI_WIN_NULL != win) MPI_Win_free(&win);
+    if (NULL != disps) free(disps);
+    if (NULL != perm) free(perm);
+    return rc;
+}
+
+
+/* ////////////////////////////////////////////////////////////////////////// */
+/**
+ * gups-style random atomics: every rank exposes a table of
+ * SMGC_GUPS_TABLE_LEN counters and increments SMGC_GUPS_NUM_UPDATES randomly
+ * chosen counters anywhere in the job with fetch_and_op, waiting for each
+ * result. no update may be lost.
+ */
+static int
+rma_gups(void)
+{
+    int i = 0, target = 0, rc = SMGC_ERROR;
+    uint64_t *table = NULL, one = 1, old = 0, r = 0, state = 0;
+    uint64_t local_sum = 0, total = 0;
+    MPI_Aint idx = 0;
+    double elapsed = 0.0;
+    double_int_t in_rate = {0.0, 0}, in_lat = {0.0, 0};
+    MPI_Win win = MPI_WIN_NULL;
+    smgc_wd_op_t *wd_op = NULL;
+
+    if (num_ranks < 2) {
+        SMGC_MPF("       at least 2 ranks are required - skipping\n");
+        return SMGC_SUCCESS;
+    }
+
+    mpi_ret_code = MPI_Win_allocate(SMGC_GUPS_TABLE_LEN * sizeof(uint64_t),
+                                    sizeof(uint64_t), MPI_INFO_NULL,
+                                    MPI_COMM_WORLD, &table, &win);
+    SMGC_MPICHK(mpi_ret_code, out);
+    mpi_ret_code = MPI_Win_lock(MPI_LOCK_EXCLUSIVE, my_rank, 0, win);
+    SMGC_MPICHK(mpi_ret_code, out);
+    memset(table, 0, SMGC_GUPS_TABLE_LEN * sizeof(uint64_t));
+    mpi_ret_code = MPI_Win_unlock(my_rank, win);
+    SMGC_MPICHK(mpi_ret_code, out);
+
+    SMGC_MPF("       table words per rank: %d, updates per rank: %d\n",
+             SMGC_GUPS_TABLE_LEN, SMGC_GUPS_NUM_UPDATES);
+
+    /* a reproducible stream per rank */
+    state = mix64(rng_seed) ^
+            mix64(((uint64_t)(uint32_t)cur_pass << 32) | (uint32_t)my_rank);
+
+    wd_op = wd_op_begin("rma_gups", 0);
+
+    mpi_ret_code = MPI_Win_lock_all(0, win);
+    SMGC_MPICHK(mpi_ret_code, out);
+    mpi_ret_code = MPI_Barrier(MPI_COMM_WORLD);
+    SMGC_MPICHK(mpi_ret_code, out);
+
+    elapsed = MPI_Wtime();
+    for (i = 0; i < SMGC_GUPS_NUM_UPDATES; ++i) {
+        r = seeded_rand(&state);
+        target = (int)(r % (uint64_t)num_ranks);
+        idx = (MPI_Aint)((r >> 32) % SMGC_GUPS_TABLE_LEN);
+        wd_op_step(wd_op, i, -1, target);
+        mpi_ret_code = MPI_Fetch_and_op(&one, &old, MPI_UINT64_T, target, idx,
+                                        MPI_SUM, win);
+        SMGC_MPICHK(mpi_ret_code, out);
+        mpi_ret_code = MPI_Win_flush(target, win);
+        SMGC_MPICHK(mpi_ret_code, out);
+    }
+    elapsed = MPI_Wtime() - elapsed;
+
+    mpi_ret_code = MPI_Win_unlock_all(win);
+    SMGC_MPICHK(mpi_ret_code, out);
+    wd_op_end(wd_op);
+    wd_op = NULL;
+    mpi_ret_code = MPI_Barrier(MPI_COMM_WORLD);
+    SMGC_MPICHK(mpi_ret_code, out);
+
+    /* every update must have landed somewhere */
+    mpi_ret_code = MPI_Win_lock(MPI_LOCK_SHARED, my_rank, 0, win);
+    SMGC_MPICHK(mpi_ret_code, out);
+    for (i = 0; i < SMGC_GUPS_TABLE_LEN; ++i) {
+        local_sum += table[i];
+    }
+    mpi_ret_code = MPI_Win_unlock(my_rank, win);
+    SMGC_MPICHK(mpi_ret_code, out);
+    mpi_ret_code = MPI_Allreduce(&local_sum, &total, 1, MPI_UINT64_T, MPI_SUM,
+                                 MPI_COMM_WORLD);
+    SMGC_MPICHK(mpi_ret_code, out);
+    if ((uint64_t)SMGC_GUPS_NUM_UPDATES * num_ranks != total) {
+        SMGC_ERR_MSG("rma_gups: invalid result detected on rank %d (%s): "
+                     "%llu of %llu updates\n", my_rank, host_name_buff,
+                     (unsigned long long)total,
+                     (unsigned long long)SMGC_GUPS_NUM_UPDATES * num_ranks);
+        goto out;
+    }
+
+    in_rate.val = SMGC_GUPS_NUM_UPDATES / elapsed / 1e6;
+    in_rate.rank = my_rank;
+    in_lat.val = elapsed / SMGC_GUPS_NUM_UPDATES * 1e6;
+    in_lat.rank = my_rank;
+    if (SMGC_SUCCESS != io_stats(in_rate, "update rate", IO_STATS_MOPS) ||
+        SMGC_SUCCESS != io_stats(in_lat, "fetch_and_op latency",
+                                 IO_STATS_TIME_US)) {
+        goto out;
+    }
+
+    rc = SMGC_SUCCESS;
+out:
+    wd_op_end(wd_op);
+    if (MPI_WIN_NULL != win) MPI_Win_free(&win);
+    return rc;
+}
+
+/* ////////////////////////////////////////////////////////////////////////// */
+/**
+ * atomic contention: every rank increments a single counter on the master
+ * SMGC_HOTSPOT_NUM_OPS times with fetch_and_op. the per-rank spread shows how
+ * fairly the target serves its origins. no increment may be lost.
+ */
+static int
+rma_hotspot(void)
+{
+    int i = 0, rc = SMGC_ERROR;
+    uint64_t *counter = NULL, one = 1, old = 0, total = 0;
+    double elapsed = 0.0;
+    double_int_t in_rate = {0.0, 0}, in_lat = {0.0, 0};
+    MPI_Win win = MPI_WIN_NULL;
+    smgc_wd_op_t *wd_op = NULL;
+
+    if (num_ranks < 2) {
+        SMGC_MPF("       at least 2 ranks are required - skipping\n");
+        return SMGC_SUCCESS;
+    }
+
+    mpi_ret_code = MPI_Win_allocate(sizeof(uint64_t), sizeof(uint64_t),
+                                    MPI_INFO_NULL, MPI_COMM_WORLD, &counter,
+                                    &win);
+    SMGC_MPICHK(mpi_ret_code, out);
+    mpi_ret_code = MPI_Win_lock(MPI_LOCK_EXCLUSIVE, my_rank, 0, win);
+    SMGC_MPICHK(mpi_ret_code, out);
+    *counter = 0;
+    mpi_ret_code = MPI_Win_unlock(my_rank, win);
+    SMGC_MPICHK(mpi_ret_code, out);
+
+    SMGC_MPF("       target: %06d (%s), increments per rank: %d\n",
+             SMGC_MASTER_RANK, host_name_buff, SMGC_HOTSPOT_NUM_OPS);
+
+    wd_op = wd_op_begin("rma_hotspot", 0);
+
+    mpi_ret_code = MPI_Win_lock_all(0, win);
+    SMGC_MPICHK(mpi_ret_code, out);
+    mpi_ret_code = MPI_Barrier(MPI_COMM_WORLD);
+    SMGC_MPICHK(mpi_ret_code, out);
+
+    elapsed = MPI_Wtime();
+    for (i = 0; i < SMGC_HOTSPOT_NUM_OPS; ++i) {
+        wd_op_step(wd_op, i, -1, SMGC_MASTER_RANK);
+        mpi_ret_code = MPI_Fetch_and_op(&one, &old, MPI_UINT64_T,
+                                        SMGC_MASTER_RANK, 0, MPI_SUM, win);
+        SMGC_MPICHK(mpi_ret_code, out);
+        mpi_ret_code = MPI_Win_flush(SMGC_MASTER_RANK, win);
+        SMGC_MPICHK(mpi_ret_code, out);
+    }
+    elapsed = MPI_Wtime() - elapsed;
+
+    mpi_ret_code = MPI_Win_unlock_all(win);
+    SMGC_MPICHK(mpi_ret_code, out);
+    wd_op_end(wd_op);
+    wd_op = NULL;
+    mpi_ret_code = MPI_Barrier(MPI_COMM_WORLD);
+    SMGC_MPICHK(mpi_ret_code, out);
+
+    if (SMGC_MASTER_RANK == my_rank) {
+        mpi_ret_code = MPI_Win_lock(MPI_LOCK_SHARED, my_rank, 0, win);
+        SMGC_MPICHK(mpi_ret_code, out);
+        total = *counter;
+        mpi_ret_code = MPI_Win_unlock(my_rank, win);
+        SMGC_MPICHK(mpi_ret_code, out);
+    }
+    mpi_ret_code = MPI_Bcast(&total, 1, MPI_UINT64_T, SMGC_MASTER_RANK,
+                             MPI_COMM_WORLD);
+    SMGC_MPICHK(mpi_ret_code, out);
+    if ((uint64_t)SMGC_HOTSPOT_NUM_OPS * num_ranks != total) {
+        SMGC_ERR_MSG("rma_hotspot: invalid result detected on rank %d (%s): "
+                     "%llu of %llu increments\n", my_rank, host_name_buff,
+                     (unsigned long long)total,
+                     (unsigned long long)SMGC_HOTSPOT_NUM_OPS * num_ranks);
+        goto out;
+    }
+
+    in_rate.val = SMGC_HOTSPOT_NUM_OPS / elapsed / 1e6;
+    in_rate.rank = my_rank;
+    in_lat.val = elapsed / SMGC_HOTSPOT_NUM_OPS * 1e6;
+    in_lat.rank = my_rank;
+    if (SMGC_SUCCESS != io_stats(in_rate, "hotspot update rate",
+                                 IO_STATS_MOPS) ||
+        SMGC_SUCCESS != io_stats(in_lat, "hotspot fetch_and_op latency",
+                                 IO_STATS_TIME_US)) {
+        goto out;
+    }
+
+    rc = SMGC_SUCCESS;
+out:
+    wd_op_end(wd_op);
+    if (MPI_WIN_NULL != win) MPI_Win_free(&win);
+    return rc;
+}
 
-    /* no work to do, return success and move on */
-    if (0 == num_fs_test_paths) {
-        SMGC_MPF("       zero paths requested via -w option. skipping test.\n");
+
+/* ////////////////////////////////////////////////////////////////////////// */
+/**
+ * sets *partner to this rank's msg_rate partner (-1: sits out): the rank with
+ * the same node rank on the paired node (nodes 2i and 2i + 1, numbered by
+ * node leader rank). on a single node, the two halves of the node are paired
+ * instead.
+ */
+static int
+msg_rate_partner(int *partner)
+{
+    int i = 0, node = 0, pnode = -1, half = 0, rc = SMGC_ERROR;
+    /* [2r]: node of rank r [2r + 1]: its node rank */
+    int in[2] = {0, 0}, *map = NULL;
+    const smgc_tier_t *nt = &tiers[1], *lt = &tiers[2];
+
+    *partner = -1;
+    if (num_nodes < 2) {
+        half = nt->size / 2;
+        if (nt->rank < 2 * half) {
+            *partner = tier_wrank(nt, (nt->rank < half) ? (nt->rank + half) :
+                                                          (nt->rank - half));
+        }
         return SMGC_SUCCESS;
     }
 
-    /* if we are here, let the games begin! */
-
-    if (NULL == (buff = (char *)malloc(buff_size * sizeof(char)))) {
-        SMGC_ERR_MSG("out of resources\n");
-        return SMGC_ERROR;
+    if (MPI_COMM_NULL != lt->comm) {
+        node = lt->rank;
     }
-    memset(buff, wr_char, buff_size);
+    mpi_ret_code = MPI_Bcast(&node, 1, MPI_INT, 0, nt->comm);
+    SMGC_MPICHK(mpi_ret_code, out);
 
-    SMGC_MPF("       file size (per rank process): %lu B\n", buff_size);
+    map = (int *)malloc(2 * num_ranks * sizeof(int));
+    SMGC_MEMCHK(map, out);
+    in[0] = node;
+    in[1] = nt->rank;
+    mpi_ret_code = MPI_Allgather(in, 2, MPI_INT, map, 2, MPI_INT,
+                                 MPI_COMM_WORLD);
+    SMGC_MPICHK(mpi_ret_code, out);
 
-    /* write to all requested paths */
-    for (i = 0; i < num_fs_test_paths; ++i) {
-        if (-1 == asprintf(&my_file_name, "%s/%s_%d", fs_test_list[i],
-                           SMGC_MPI_FILE_NAME, my_rank)) {
-            SMGC_ERR_MSG("out of resources\n");
-            goto out;
-        }
-        if (NULL == my_file_name) {
-            SMGC_ERR_MSG("out of resources\n");
-            goto out;
+    /* with an odd number of nodes, the last one sits out */
+    pnode = ((node ^ 1) < num_nodes) ? (node ^ 1) : -1;
+    for (i = 0; pnode >= 0 && i < num_ranks; ++i) {
+        if (pnode == map[2 * i] && nt->rank == map[2 * i + 1]) {
+            *partner = i;
+            break;
         }
+    }
 
-        /* let the user know we are working on it */
-        SMGC_MPF("   === mpi_comm_world: writing to %s\n", fs_test_list[i]);
+    rc = SMGC_SUCCESS;
+out:
+    if (NULL != map) free(map);
+    return rc;
+}
 
-        /* barrier before we start */
-        mpi_rc = MPI_Barrier(MPI_COMM_WORLD);
-        SMGC_MPICHK(mpi_rc, out);
+/* ////////////////////////////////////////////////////////////////////////// */
+/**
+ * lists the nodes whose aggregate message rate is below SMGC_MRATE_SLOW_FRAC
+ * of the median node. node_rate < 0 marks a node that sat out. called by the
+ * node leaders.
+ */
+static int
+msg_rate_slow_nodes(double node_rate)
+{
+    int i = 0, n = 0, rc = SMGC_ERROR;
+    const smgc_tier_t *lt = &tiers[2];
+    double *rates = NULL, *sorted = NULL, median = 0.0;
 
-        open_time = MPI_Wtime();
-        if (-1 == (fd = open(my_file_name, O_CREAT | O_RDWR, 0600))) {
-            int error = errno;
-            SMGC_ERR_MSG("open failed with errno: %d (%s)\n", error,
-                         strerror(error));
-            goto out;
-        }
+    if (SMGC_MASTER_RANK == my_rank) {
+        rates = (double *)malloc(2 * lt->size * sizeof(double));
+        SMGC_MEMCHK(rates, out);
+        sorted = rates + lt->size;
+    }
+    mpi_ret_code = MPI_Gather(&node_rate, 1, MPI_DOUBLE, rates, 1,
+                              MPI_DOUBLE, 0, lt->comm);
+    SMGC_MPICHK(mpi_ret_code, out);
 
-        write_start = MPI_Wtime();
-        if (-1 == (bytes_written = write(fd, buff, buff_size))) {
-            int error = errno;
-            SMGC_ERR_MSG("write failed with errno: %d (%s)\n", error,
-                         strerror(error));
-            goto out;
+    if (SMGC_MASTER_RANK == my_rank) {
+        for (i = 0; i < lt->size; ++i) {
+            if (rates[i] >= 0.0) {
+                sorted[n++] = rates[i];
+            }
         }
-        write_fin = MPI_Wtime();
-
-        /* seek to beginning of file - time this step so we can subtract the
-         * time spent here from our bw calculations
-         */
-        lseek_start = MPI_Wtime();
-        if(-1 == lseek(fd, 0, SEEK_SET)) {
-            int error = errno;
-            SMGC_ERR_MSG("lseek failed with errno: %d (%s)\n", error,
-                         strerror(error));
-            goto out;
+        if (n > 0) {
+            qsort(sorted, n, sizeof(double), qsort_cmp_dbl);
+            median = sorted[n / 2];
         }
-        lseek_fin = MPI_Wtime();
+        for (i = 0; i < lt->size; ++i) {
+            if (rates[i] >= 0.0 && rates[i] < SMGC_MRATE_SLOW_FRAC * median) {
+                SMGC_MPF("       slow node: %06d (%s): %.3f Mmsg/s (%.0f%% "
+                         "of the median node)\n", tier_wrank(lt, i),
+                         get_rhn(tier_wrank(lt, i)), rates[i],
+                         rates[i] / median * 100.0);
+            }
+        }
+    }
 
-        memset_start = MPI_Wtime();
-        /* overwrite buff's contents before read */
-        memset(buff, clobber_char, buff_size);
-        memset_fin = MPI_Wtime();
+    rc = SMGC_SUCCESS;
+out:
+    if (NULL != rates) free(rates);
+    return rc;
+}
 
-        read_start = MPI_Wtime();
-        if (-1 == (bytes_read = read(fd, buff, buff_size))) {
-            int error = errno;
-            SMGC_ERR_MSG("read failed with errno: %d (%s)\n", error,
-                         strerror(error));
-            goto out;
-        }
-        read_fin = MPI_Wtime();
+/* ////////////////////////////////////////////////////////////////////////// */
+/**
+ * small message injection rate. every rank streams windows of
+ * SMGC_MRATE_WINDOW non-blocking SMGC_MRATE_MSG_SIZE B messages to and from
+ * its peer on a paired node (see: msg_rate_partner), so all ranks of a node
+ * load its nic at once. reports messages per second per rank and per node
+ * and lists the nodes that fall well short of the median.
+ */
+static int
+msg_rate(void)
+{
+    int w = 0, k = 0, tag = 42, partner = -1, rc = SMGC_ERROR;
+    char *sbuf = NULL, *rbuf = NULL;
+    double elapsed = 0.0, rate = -1.0, rank_rate = 0.0, node_rate = 0.0;
+    bool is_leader = (MPI_COMM_NULL != tiers[2].comm);
+    MPI_Request *reqs = NULL;
+    smgc_wd_op_t *wd_op = NULL;
+
+    if (num_ranks < 2) {
+        SMGC_MPF("       at least 2 ranks are required - skipping\n");
+        return SMGC_SUCCESS;
+    }
 
-        if (0 != close(fd)) {
-            int error = errno;
-            SMGC_ERR_MSG("close failed with errno: %d (%s)\n", error,
-                         strerror(error));
-            goto out;
-        }
-        close_time = MPI_Wtime();
+    if (SMGC_SUCCESS != msg_rate_partner(&partner)) {
+        goto out;
+    }
+    sbuf = (char *)arena_get(SMGC_MRATE_MSG_SIZE);
+    SMGC_MEMCHK(sbuf, out);
+    rbuf = (char *)arena_get(SMGC_MRATE_WINDOW * SMGC_MRATE_MSG_SIZE);
+    SMGC_MEMCHK(rbuf, out);
+    reqs = (MPI_Request *)malloc(2 * SMGC_MRATE_WINDOW * sizeof(MPI_Request));
+    SMGC_MEMCHK(reqs, out);
+
+    SMGC_MPF("       message size: %d B, window: %d, messages per rank: %d\n",
+             SMGC_MRATE_MSG_SIZE, SMGC_MRATE_WINDOW,
+             SMGC_MRATE_WINDOW * SMGC_MRATE_NUM_WINDOWS);
+    SMGC_MPF("       pairing: %s\n", (num_nodes < 2) ?
+             "halves of a single node (intra-node)" :
+             "node 2i with node 2i + 1 (inter-node)");
+
+    if (partner >= 0) {
+        payload_prep(sbuf, SMGC_MRATE_MSG_SIZE, my_rank, partner, 0);
+    }
 
-        fd = -1;
+    wd_op = wd_op_begin("msg_rate", 0);
 
-        if (0 != unlink(my_file_name)) {
-            int error = errno;
-            SMGC_ERR_MSG("unlink failed with errno: %d (%s)\n", error,
-                         strerror(error));
-            goto out;
+    mpi_ret_code = MPI_Barrier(MPI_COMM_WORLD);
+    SMGC_MPICHK(mpi_ret_code, out);
+
+    elapsed = MPI_Wtime();
+    for (w = 0; w < SMGC_MRATE_NUM_WINDOWS && partner >= 0; ++w) {
+        wd_op_step(wd_op, w, partner, partner);
+        for (k = 0; k < SMGC_MRATE_WINDOW; ++k) {
+            mpi_ret_code = MPI_Irecv(rbuf + k * SMGC_MRATE_MSG_SIZE,
+                                     SMGC_MRATE_MSG_SIZE, MPI_CHAR, partner,
+                                     tag, MPI_COMM_WORLD, &reqs[k]);
+            SMGC_MPICHK(mpi_ret_code, out);
         }
-        /* check integrity of read */
-        if (bytes_written != bytes_read) {
-            SMGC_ERR_MSG("write/read mismatch.  wrote %lu read %lu\n",
-                         bytes_written, bytes_read);
-            goto out;
+        for (k = 0; k < SMGC_MRATE_WINDOW; ++k) {
+            mpi_ret_code = MPI_Isend(sbuf, SMGC_MRATE_MSG_SIZE, MPI_CHAR,
+                                     partner, tag, MPI_COMM_WORLD,
+                                     &reqs[SMGC_MRATE_WINDOW + k]);
+            SMGC_MPICHK(mpi_ret_code, out);
         }
-        /* iterate over char buff - making certain all is well */
-        for (j = 0; j < bytes_written; ++j) {
-            if (wr_char != buff[j]) {
-                SMGC_ERR_MSG(
-                    "characters read do not match characters written!\n"
-                );
-                goto out;
-            }
+        mpi_ret_code = MPI_Waitall(2 * SMGC_MRATE_WINDOW, reqs,
+                                   MPI_STATUSES_IGNORE);
+        SMGC_MPICHK(mpi_ret_code, out);
+    }
+    elapsed = MPI_Wtime() - elapsed;
+
+    wd_op_end(wd_op);
+    wd_op = NULL;
+
+    /* the last window */
+    for (k = 0; k < SMGC_MRATE_WINDOW && partner >= 0; ++k) {
+        if (SMGC_SUCCESS != payload_verify(rbuf + k * SMGC_MRATE_MSG_SIZE,
+                                           SMGC_MRATE_MSG_SIZE, partner,
+                                           my_rank, 0)) {
+            goto out;
         }
+    }
 
-        /* subtract time not spent in benchmarked routines */
-        effe_bw_time_fix = (lseek_fin - lseek_start) +
-                           (memset_fin - memset_start);
+    if (partner >= 0) {
+        rate = (double)SMGC_MRATE_WINDOW * SMGC_MRATE_NUM_WINDOWS / elapsed /
+               1e6;
+    }
+    /* a node's rate is the sum over its ranks. its leader always has a
+     * partner, unless the whole node sits out.
+     */
+    rank_rate = (rate < 0.0) ? 0.0 : rate;
+    mpi_ret_code = MPI_Reduce(&rank_rate, &node_rate, 1, MPI_DOUBLE, MPI_SUM,
+                              0, tiers[1].comm);
+    SMGC_MPICHK(mpi_ret_code, out);
+    if (rate < 0.0) {
+        node_rate = -1.0;
+    }
 
-        /* calculate bandwidths */
+    SMGC_MPF("       %-26s %10s %10s %10s %12s  %s\n", "rate (Mmsg/s)", "min",
+             "ave", "max", "aggregate", "min rank");
+    if (SMGC_SUCCESS != rate_row_stats("per rank", rate) ||
+        SMGC_SUCCESS != rate_row_stats("per node", is_leader ? node_rate :
+                                                               -1.0)) {
+        goto out;
+    }
+    if (num_nodes > 1 && is_leader &&
+        SMGC_SUCCESS != msg_rate_slow_nodes(node_rate)) {
+        goto out;
+    }
+    if (SMGC_SUCCESS != payload_verify_stats(MPI_COMM_WORLD)) {
+        goto out;
+    }
 
-        /* negative and 0 length file size protection provided by lower level */
-        /* zero value fixup - good enough for our purposes */
+    rc = SMGC_SUCCESS;
+out:
+    wd_op_end(wd_op);
+    if (NULL != reqs) free(reqs);
+    return rc;
+}
 
-        /* effective bandwidth */
-        if (0.0 >= (tmp_dbl = ((close_time - open_time) - effe_bw_time_fix))) {
-            effe_bw = 0.0;
-        }
-        else {
-            effe_bw = ((double)buff_size / tmp_dbl / (double)SMGC_MB_SIZE);
-        }
-        /* write bandwidth */
-        if (0.0 >= (tmp_dbl = (write_fin - write_start))) {
-            write_bw = 0.0;
-        }
-        else {
-            write_bw = ((double)buff_size / tmp_dbl / (double)SMGC_MB_SIZE);
-        }
-        /* read bandwidth */
-        if (0.0 >= (tmp_dbl = (read_fin - read_start))) {
-            read_bw = 0.0;
-        }
-        else {
-            read_bw = ((double)buff_size / tmp_dbl / (double)SMGC_MB_SIZE);
-        }
+/* ////////////////////////////////////////////////////////////////////////// */
+/**
+ * checks SMGC_SHM_PATH and lists the nodes where sendrecv falls far short of
+ * load/store (ratio: sendrecv over load/store bandwidth, < 0: the node sat
+ * out) and the nodes that are running out of shared memory space. called by
+ * the node leaders.
+ */
+static int
+shm_bw_nodes(double ratio)
+{
+    int i = 0, rc = SMGC_ERROR;
+    const smgc_tier_t *lt = &tiers[2];
+    /* [0]: ratio [1]: free MB [2]: total MB (< 0: not available) */
+    double in[3] = {ratio, -1.0, -1.0}, *all = NULL, *nd = NULL;
+    double min_free = -1.0, min_total = 0.0;
+    int min_node = -1;
+#ifdef HAVE_SYS_STATVFS_H
+    struct statvfs vfs;
+
+    if (0 == statvfs(SMGC_SHM_PATH, &vfs)) {
+        in[1] = (double)vfs.f_bavail * vfs.f_frsize / SMGC_MB_SIZE;
+        in[2] = (double)vfs.f_blocks * vfs.f_frsize / SMGC_MB_SIZE;
+    }
+#endif
 
-        /* prepare values for reduce */
-        in_effe.val = effe_bw;
-        in_effe.rank = my_rank;
-        in_wr.val = write_bw;
-        in_wr.rank = my_rank;
-        in_rd.val = read_bw;
-        in_rd.rank = my_rank;
+    if (SMGC_MASTER_RANK == my_rank) {
+        all = (double *)malloc(3 * lt->size * sizeof(double));
+        SMGC_MEMCHK(all, out);
+    }
+    mpi_ret_code = MPI_Gather(in, 3, MPI_DOUBLE, all, 3, MPI_DOUBLE, 0,
+                              lt->comm);
+    SMGC_MPICHK(mpi_ret_code, out);
 
-        /* calculate effective bandwidth stats */
-        if (SMGC_SUCCESS != (rc = io_stats(in_effe, "effective write bandwidth",
-                                           IO_STATS_MBS))) {
-            goto out;
+    if (SMGC_MASTER_RANK != my_rank) {
+        rc = SMGC_SUCCESS;
+        goto out;
+    }
+    for (i = 0; i < lt->size; ++i) {
+        nd = all + 3 * i;
+        if (nd[0] >= 0.0 && nd[0] < SMGC_SHM_SLOW_FRAC) {
+            SMGC_MPF("       slow node: %06d (%s): sendrecv at %.0f%% of "
+                     "load/store\n", tier_wrank(lt, i),
+                     get_rhn(tier_wrank(lt, i)), nd[0] * 100.0);
         }
-        /* calculate write bandwidth stats */
-        if (SMGC_SUCCESS != (rc = io_stats(in_wr, "pure write bandwidth",
-                                           IO_STATS_MBS))) {
-            goto out;
+        if (nd[2] <= 0.0) {
+            SMGC_MPF("       %s not available: %06d (%s)\n", SMGC_SHM_PATH,
+                     tier_wrank(lt, i), get_rhn(tier_wrank(lt, i)));
+            continue;
         }
-        /* calculate read bandwidth stats */
-        if (SMGC_SUCCESS != (rc = io_stats(in_rd, "pure read bandwidth",
-                                           IO_STATS_MBS))) {
-            goto out;
+        if (nd[1] < SMGC_SHM_MIN_FREE_FRAC * nd[2]) {
+            SMGC_MPF("       %s nearly full: %06d (%s): %.0f MB of %.0f MB "
+                     "free\n", SMGC_SHM_PATH, tier_wrank(lt, i),
+                     get_rhn(tier_wrank(lt, i)), nd[1], nd[2]);
         }
-
-        /* all is well for this iteration */
-        if (NULL != my_file_name) {
-            free(my_file_name);
-            my_file_name = NULL;
+        if (min_node < 0 || nd[1] < min_free) {
+            min_free = nd[1];
+            min_total = nd[2];
+            min_node = i;
         }
     }
+    if (min_node >= 0) {
+        SMGC_MPF("       %s min free: %.0f MB of %.0f MB on %06d (%s)\n",
+                 SMGC_SHM_PATH, min_free, min_total, tier_wrank(lt, min_node),
+                 get_rhn(tier_wrank(lt, min_node)));
+    }
 
-    /* all is well */
     rc = SMGC_SUCCESS;
 out:
-    if (-1 != fd) {
-        close(fd);
-        unlink(my_file_name);
-    }
-    if (NULL != buff) free(buff);
-    if (NULL != my_file_name) free(my_file_name);
+    if (NULL != all) free(all);
     return rc;
 }
 
 /* ////////////////////////////////////////////////////////////////////////// */
+/**
+ * intra-node bandwidth. node rank r is paired with node rank r + n / 2. for
+ * every size, each rank first copies straight into its peer's part of an
+ * MPI_Win_allocate_shared segment (load/store), then exchanges the same
+ * amount with MPI_Sendrecv on the node communicator. one row per size and
+ * path. nodes where sendrecv falls far short of load/store at the largest
+ * size and nodes short of space in SMGC_SHM_PATH are listed.
+ */
 static int
-hello_world(void)
+shm_bw(void)
 {
-    int res_len = 0;
-    char name_buff[MPI_MAX_PROCESSOR_NAME + 1];
+    int k = 0, s = 0, size = 0, tag = 42, half = 0, peer = MPI_PROC_NULL;
+    int peer_w = -1, disp = 0, rc = SMGC_ERROR;
+    const smgc_tier_t *nt = &tiers[1];
+    bool is_leader = (MPI_COMM_NULL != tiers[2].comm);
+    char *base = NULL, *pbase = NULL, *sbuf = NULL, *rbuf = NULL;
+    char label[64];
+    double t = 0.0, shm = -1.0, mpi = -1.0, ratio = -1.0;
+    /* [0]: sendrecv [1]: load/store bandwidth over the node (largest size) */
+    double in_sum[2] = {0.0, 0.0}, out_sum[2] = {0.0, 0.0};
+    MPI_Aint psize = 0;
+    MPI_Win win = MPI_WIN_NULL;
+    smgc_wd_op_t *wd_op = NULL;
+
+    if (max_node_ranks < 2) {
+        SMGC_MPF("       at least 2 ranks per node are required - skipping\n");
+        return SMGC_SUCCESS;
+    }
 
-    mpi_ret_code = MPI_Get_processor_name(name_buff, &res_len);
-    SMGC_MPICHK(mpi_ret_code, err);
+    half = nt->size / 2;
+    if (nt->rank < 2 * half) {
+        peer = (nt->rank < half) ? (nt->rank + half) : (nt->rank - half);
+        peer_w = tier_wrank(nt, peer);
+    }
 
-    SMGC_FPF(stdout, "       hello from rank %06d (%s) of %06d\n", my_rank,
-             name_buff, num_ranks);
+    /* [0, max): what this rank copies out [max, 2 max): what its peer copies
+     * in
+     */
+    mpi_ret_code = MPI_Win_allocate_shared(2 * (MPI_Aint)SMGC_SHM_MAX_SIZE, 1,
+                                           MPI_INFO_NULL, nt->comm, &base,
+                                           &win);
+    SMGC_MPICHK(mpi_ret_code, out);
+    if (peer_w >= 0) {
+        mpi_ret_code = MPI_Win_shared_query(win, peer, &psize, &disp, &pbase);
+        SMGC_MPICHK(mpi_ret_code, out);
+    }
+    mpi_ret_code = MPI_Win_lock_all(MPI_MODE_NOCHECK, win);
+    SMGC_MPICHK(mpi_ret_code, out);
 
-    return SMGC_SUCCESS;
-err:
-    return SMGC_ERROR;
-}
+    sbuf = (char *)arena_get(SMGC_SHM_MAX_SIZE);
+    SMGC_MEMCHK(sbuf, out);
+    rbuf = (char *)arena_get(SMGC_SHM_MAX_SIZE);
+    SMGC_MEMCHK(rbuf, out);
+
+    SMGC_MPF("       pairing: node rank r with r + ranks per node / 2\n");
+    SMGC_MPF("       copies per size and path: %d\n", SMGC_SHM_NUM_ITRS);
+    SMGC_MPF("       %-26s %10s %10s %10s %12s  %s\n", "bandwidth ("
+             SMGC_MBS_UNIT_STR ")", "min", "ave", "max", "aggregate",
+             "min rank");
+
+    wd_op = wd_op_begin("shm_bw", 0);
+
+    for (size = SMGC_SHM_MIN_SIZE; size <= SMGC_SHM_MAX_SIZE;
+         size *= SMGC_SHM_SIZE_FACTOR, ++s) {
+        wd_op_step(wd_op, s, peer_w, peer_w);
+
+        /* load/store */
+        if (peer_w >= 0) {
+            payload_prep(base, size, my_rank, peer_w, s);
+        }
+        mpi_ret_code = MPI_Win_sync(win);
+        SMGC_MPICHK(mpi_ret_code, out);
+        mpi_ret_code = MPI_Barrier(nt->comm);
+        SMGC_MPICHK(mpi_ret_code, out);
+        t = MPI_Wtime();
+        for (k = 0; k < SMGC_SHM_NUM_ITRS && peer_w >= 0; ++k) {
+            memcpy(pbase + SMGC_SHM_MAX_SIZE, base, size);
+        }
+        mpi_ret_code = MPI_Win_sync(win);
+        SMGC_MPICHK(mpi_ret_code, out);
+        t = MPI_Wtime() - t;
+        /* wait for the peer's copies to land */
+        mpi_ret_code = MPI_Barrier(nt->comm);
+        SMGC_MPICHK(mpi_ret_code, out);
+        mpi_ret_code = MPI_Win_sync(win);
+        SMGC_MPICHK(mpi_ret_code, out);
+        if (peer_w >= 0) {
+            if (SMGC_SUCCESS != payload_verify(base + SMGC_SHM_MAX_SIZE, size,
+                                               peer_w, my_rank, s)) {
+                goto out;
+            }
+            shm = (double)size * SMGC_SHM_NUM_ITRS / t / SMGC_MB_SIZE;
+        }
 
-/* ////////////////////////////////////////////////////////////////////////// */
-static int
-stat_paths(void)
-{
-    int i = 0;
-    struct stat buff;
-    /* nothing to do, so that's easy */
-    if (0 == num_stat_paths) {
-        SMGC_MPF("       zero paths requested via -s option. skipping test.\n");
-        return SMGC_SUCCESS;
-    }
+        /* the mpi library's shared memory path */
+        if (peer_w >= 0) {
+            payload_prep(sbuf, size, my_rank, peer_w, s);
+        }
+        mpi_ret_code = MPI_Barrier(nt->comm);
+        SMGC_MPICHK(mpi_ret_code, out);
+        t = MPI_Wtime();
+        for (k = 0; k < SMGC_SHM_NUM_ITRS && peer_w >= 0; ++k) {
+            mpi_ret_code = MPI_Sendrecv(sbuf, size, MPI_CHAR, peer, tag, rbuf,
+                                        size, MPI_CHAR, peer, tag, nt->comm,
+                                        MPI_STATUS_IGNORE);
+            SMGC_MPICHK(mpi_ret_code, out);
+        }
+        t = MPI_Wtime() - t;
+        if (peer_w >= 0) {
+            if (SMGC_SUCCESS != payload_verify(rbuf, size, peer_w, my_rank,
+                                               s)) {
+                goto out;
+            }
+            mpi = (double)size * SMGC_SHM_NUM_ITRS / t / SMGC_MB_SIZE;
+        }
 
-    for (i = 0; i < num_stat_paths; ++i) {
-        SMGC_MPF("       mpi_comm_world: stating %s\n", stat_list[i]);
-        /* try to stat the file */
-        if (0 != stat(stat_list[i], &buff)) {
-            SMGC_FPF(stderr, "   !!! rank %d (%s) unable to stat %s\n", my_rank,
-                     host_name_buff, stat_list[i]);
-            return SMGC_ERROR;
+        snprintf(label, sizeof(label), "%d B load/store", size);
+        if (SMGC_SUCCESS != rate_row_stats(label, shm)) {
+            goto out;
+        }
+        snprintf(label, sizeof(label), "%d B sendrecv", size);
+        if (SMGC_SUCCESS != rate_row_stats(label, mpi)) {
+            goto out;
         }
     }
-    return SMGC_SUCCESS;
-}
 
-/* ////////////////////////////////////////////////////////////////////////// */
-static void
-kill_mpi_messaging(int sig)
-{
-    (void)sig;
-    /* no check in error path  - hope for the best */
-    gethostname(host_name_buff, SMGC_HOST_NAME_MAX - 1);
-    host_name_buff[SMGC_HOST_NAME_MAX - 1] = '\0';
+    wd_op_end(wd_op);
+    wd_op = NULL;
+    mpi_ret_code = MPI_Win_unlock_all(win);
+    SMGC_MPICHK(mpi_ret_code, out);
 
-    fprintf(stderr, "\n########## HANG DETECTED "
-            "[on loop iteration: %d] %d (%s) ==> %d (%s) ==> %d (%s) "
-            "##########\n",
-            glob_loop_iter, glob_l_neighbor, get_rhn(glob_l_neighbor), my_rank,
-            host_name_buff, glob_r_neighbor, get_rhn(glob_r_neighbor));
+    /* compare the paths node by node at the largest size */
+    in_sum[0] = (mpi < 0.0) ? 0.0 : mpi;
+    in_sum[1] = (shm < 0.0) ? 0.0 : shm;
+    mpi_ret_code = MPI_Reduce(in_sum, out_sum, 2, MPI_DOUBLE, MPI_SUM, 0,
+                              nt->comm);
+    SMGC_MPICHK(mpi_ret_code, out);
+    if (out_sum[1] > 0.0) {
+        ratio = out_sum[0] / out_sum[1];
+    }
+    if (is_leader && SMGC_SUCCESS != shm_bw_nodes(ratio)) {
+        goto out;
+    }
+    if (SMGC_SUCCESS != payload_verify_stats(MPI_COMM_WORLD)) {
+        goto out;
+    }
 
-    exit(EXIT_FAILURE);
+    rc = SMGC_SUCCESS;
+out:
+    wd_op_end(wd_op);
+    if (MPI_WIN_NULL != win) MPI_Win_free(&win);
+    return rc;
 }
 
 /* ////////////////////////////////////////////////////////////////////////// */
-#if SMGC_HAVE_CELL_SUPPORT == 1
-
-/* in seconds */
-#define CELL_TEST_TIMEOUT 480
-
-/* ////////////////////////////////////////////////////////////////////////// */
-static void
-kill_cell_check(void)
+/**
+ * returns the resident set size (kB) of this process, -1 if it is not known.
+ */
+static long
+vm_rss_kb(void)
 {
-    /* no check in error path  - hope for the best */
-    gethostname(host_name_buff, SMGC_HOST_NAME_MAX - 1);
-    host_name_buff[SMGC_HOST_NAME_MAX - 1] = '\0';
-
-    SMGC_ERR_MSG(
-        "rank %d (%s) unable to execute cell_sanity test within %d s.\n",
-         my_rank, host_name_buff, CELL_TEST_TIMEOUT);
+    long kb = -1;
+    char line[256];
+    FILE *fp = fopen("/proc/self/status", "r");
 
-    exit(EXIT_FAILURE);
+    if (NULL == fp) {
+        return -1;
+    }
+    while (NULL != fgets(line, sizeof(line), fp)) {
+        if (1 == sscanf(line, "VmRSS: %ld", &kb)) {
+            break;
+        }
+    }
+    fclose(fp);
+    return kb;
 }
 
 /* ////////////////////////////////////////////////////////////////////////// */
+/**
+ * creates *comm out of mpi_comm_world with constructor op (SMGC_CC_*). ranks
+ * that op leaves out (odd ranks, for create_group) get MPI_COMM_NULL.
+ */
 static int
-cell_sanity(void)
+cc_create(int op, MPI_Group even_grp, MPI_Comm *comm)
 {
-    unsigned long rc = 0;
-    struct itimerval itimer;
+    int color = 0, key = my_rank, side = 1;
+    uint64_t state = 0;
+    MPI_Request req = MPI_REQUEST_NULL;
 
-    itimer.it_value.tv_sec = CELL_TEST_TIMEOUT;
-    itimer.it_value.tv_usec = 0;
-    itimer.it_interval = itimer.it_value;
+    *comm = MPI_COMM_NULL;
+    mpi_ret_code = MPI_SUCCESS;
 
-    SMGC_MPF("       mpi_comm_world: running cell diagnostics\n");
+    switch (op) {
+        case SMGC_CC_DUP:
+            mpi_ret_code = MPI_Comm_dup(MPI_COMM_WORLD, comm);
+            break;
 
-    signal(SIGALRM, (void(*)(int))&kill_cell_check);
-    setitimer(ITIMER_REAL, &itimer, NULL);
+        case SMGC_CC_IDUP:
+            /* timed to completion */
+            mpi_ret_code = MPI_Comm_idup(MPI_COMM_WORLD, comm, &req);
+            if (MPI_SUCCESS == mpi_ret_code) {
+                mpi_ret_code = MPI_Wait(&req, MPI_STATUS_IGNORE);
+            }
+            break;
 
-    if (0 != (rc = cell_check(CELL_CHECK_MSG_FAIL, CELL_CHECK_TEST_ALL))) {
-        SMGC_ERR_MSG("cell_check failure - return code: %lu\n", rc);
-        goto err;
-    }
-    else {
-        /* all is well... disable the alarm */
-        itimer.it_value.tv_sec = 0;
-        itimer.it_value.tv_usec = 0;
-        itimer.it_interval = itimer.it_value;
-        setitimer(ITIMER_REAL, &itimer, NULL);
-    }
+        case SMGC_CC_SPLIT_TYPE:
+            mpi_ret_code = MPI_Comm_split_type(MPI_COMM_WORLD,
+                                               MPI_COMM_TYPE_SHARED, my_rank,
+                                               MPI_INFO_NULL, comm);
+            break;
+
+        case SMGC_CC_CREATE_GROUP:
+            /* only the members of the group take part */
+            if (0 == my_rank % 2) {
+                mpi_ret_code = MPI_Comm_create_group(MPI_COMM_WORLD, even_grp,
+                                                     42, comm);
+            }
+            break;
 
+        default:
+            /* the splits differ in their colors (and keys) only */
+            for (side = 1; side * side < num_ranks; ++side) {
+                ;
+            }
+            if (SMGC_CC_SPLIT_TWO == op) {
+                color = my_rank % 2;
+            }
+            else if (SMGC_CC_SPLIT_BLOCKS == op) {
+                color = my_rank / side;
+            }
+            else if (SMGC_CC_SPLIT_RAND == op) {
+                /* reproducible with --seed, shuffles ranks within colors */
+                state = pass_seed(SMGC_SEED_CC_COLOR) + (uint64_t)my_rank;
+                color = (int)(seeded_rand(&state) % (uint64_t)side);
+                key = (int)(seeded_rand(&state) % (uint64_t)num_ranks);
+            }
+            else if (SMGC_CC_SPLIT_SELF == op) {
+                color = my_rank;
+            }
+            mpi_ret_code = MPI_Comm_split(MPI_COMM_WORLD, color, key, comm);
+            break;
+    }
+    SMGC_MPICHK(mpi_ret_code, err);
     return SMGC_SUCCESS;
 err:
     return SMGC_ERROR;
 }
-#endif /* SMGC_HAVE_CELL_SUPPORT */
 
 /* ////////////////////////////////////////////////////////////////////////// */
+/**
+ * prints one comm_create row: the fastest, median (of the per-rank medians)
+ * and slowest creation time, the average and largest memory growth per
+ * communicator and the rank with the slowest creation. t holds this rank's
+ * n sorted creation times (us) - n == 0: the rank sat out. kb < 0: unknown.
+ */
 static int
-mpi_io(void)
+cc_row(const char *label, int n, const double *t, double kb)
 {
-    int mpi_ret_code = MPI_ERR_OTHER, num_elems = 0, i = 0, rc = SMGC_ERROR;
-    /* access mode flags */
-    int amode = MPI_MODE_RDWR | MPI_MODE_CREATE | MPI_MODE_DELETE_ON_CLOSE;
-    char *buff = NULL, path_buff[SMGC_PATH_MAX];
-    /* i/o time markers */
-    double effe_start = 0.0, effe_fin = 0.0;
-    double write_start = 0.0, write_fin = 0.0, read_start = 0.0, read_fin = 0.0;
-    /* bandwidth variables */
-    double effe_bw = 0.0, write_bw = 0.0, read_bw = 0.0, effe_bw_time_fix = 0.0,
-           gete_start = 0.0, gete_fin = 0.0, gete_start2 = 0.0, gete_fin2 = 0.0;
-    double tmp_dbl = 0.0;
-    /* structs for min/max */
-    double_int_t in_wr = {0.0, 0}, in_rd = {0.0, 0}, in_effe = {0.0, 0};
-    /* file handle */
-    MPI_File mpi_fh;
-    MPI_Status status;
-    MPI_Offset offset = (MPI_Offset)(my_rank * file_size);
+    int i = 0, m = 0, rc = SMGC_ERROR;
+    double in_min = (n > 0) ? t[0] : DBL_MAX, min = 0.0;
+    double med = (n > 0) ? t[n / 2] : -1.0, *meds = NULL;
+    /* [0]: kB [1]: ranks that know */
+    double in_kb[2] = {(kb < 0.0) ? 0.0 : kb, (kb < 0.0) ? 0.0 : 1.0};
+    double out_kb[2] = {0.0, 0.0}, max_kb = 0.0;
+    double_int_t in_max = {(n > 0) ? t[n - 1] : -1.0, my_rank},
+                 max = {0.0, 0};
 
-    /* no writing to do, so return SMGC_SUCCESS */
-    if (0 == num_fs_test_paths) {
-        SMGC_MPF("       zero paths requested via -w option. skipping test.\n");
-        return SMGC_SUCCESS;
+    if (SMGC_MASTER_RANK == my_rank) {
+        meds = (double *)malloc(num_ranks * sizeof(double));
+        SMGC_MEMCHK(meds, out);
     }
+    mpi_ret_code = MPI_Gather(&med, 1, MPI_DOUBLE, meds, 1, MPI_DOUBLE,
+                              SMGC_MASTER_RANK, MPI_COMM_WORLD);
+    SMGC_MPICHK(mpi_ret_code, out);
+    mpi_ret_code = MPI_Reduce(&in_min, &min, 1, MPI_DOUBLE, MPI_MIN,
+                              SMGC_MASTER_RANK, MPI_COMM_WORLD);
+    SMGC_MPICHK(mpi_ret_code, out);
+    mpi_ret_code = MPI_Reduce(&in_max, &max, 1, MPI_DOUBLE_INT, MPI_MAXLOC,
+                              SMGC_MASTER_RANK, MPI_COMM_WORLD);
+    SMGC_MPICHK(mpi_ret_code, out);
+    mpi_ret_code = MPI_Reduce(in_kb, out_kb, 2, MPI_DOUBLE, MPI_SUM,
+                              SMGC_MASTER_RANK, MPI_COMM_WORLD);
+    SMGC_MPICHK(mpi_ret_code, out);
+    mpi_ret_code = MPI_Reduce(&in_kb[0], &max_kb, 1, MPI_DOUBLE, MPI_MAX,
+                              SMGC_MASTER_RANK, MPI_COMM_WORLD);
+    SMGC_MPICHK(mpi_ret_code, out);
 
-    buff = (char *)malloc(file_size * sizeof(char));
-    SMGC_MEMCHK(buff, out);
-
-    memset(buff, 'j', (size_t)(file_size * sizeof(char)));
+    if (SMGC_MASTER_RANK == my_rank) {
+        for (i = 0; i < num_ranks; ++i) {
+            if (meds[i] >= 0.0) {
+                meds[m++] = meds[i];
+            }
+        }
+        qsort(meds, m, sizeof(double), qsort_cmp_dbl);
+        SMGC_MPF("       %-26s %10.1f %10.1f %10.1f %10.1f %10.1f  %06d (%s)\n",
+                 label, min, (m > 0) ? meds[m / 2] : 0.0, max.val,
+                 (out_kb[1] > 0.0) ? out_kb[0] / out_kb[1] : 0.0, max_kb,
+                 max.rank, get_rhn(max.rank));
+    }
 
-    /* if we are here, then let the real work begin */
+    rc = SMGC_SUCCESS;
+out:
+    if (NULL != meds) free(meds);
+    return rc;
+}
 
-    SMGC_MPF("       file size (per rank process): %lu B\n", file_size);
+/* ////////////////////////////////////////////////////////////////////////// */
+/**
+ * communicator creation. for every constructor (see: cc_names), creates
+ * SMGC_CC_NUM_ITRS communicators out of mpi_comm_world, keeping all of them
+ * until the last one is created, so context ids pile up the way they do in
+ * applications that build many communicators at startup. reports the
+ * creation time distribution and the resident memory growth per
+ * communicator (from /proc/self/status).
+ */
+static int
+comm_create(void)
+{
+    int op = 0, k = 0, n = 0, rc = SMGC_ERROR;
+    int range[1][3] = {{0, 0, 2}};
+    long rss = 0, rss_after = 0;
+    double t = 0.0, kb = 0.0, times[SMGC_CC_NUM_ITRS];
+    MPI_Comm comms[SMGC_CC_NUM_ITRS];
+    MPI_Group world_grp = MPI_GROUP_NULL, even_grp = MPI_GROUP_NULL;
+    smgc_wd_op_t *wd_op = NULL;
+
+    for (k = 0; k < SMGC_CC_NUM_ITRS; ++k) {
+        comms[k] = MPI_COMM_NULL;
+    }
+    /* create_group: the even ranks */
+    range[0][1] = num_ranks - 1;
+    mpi_ret_code = MPI_Comm_group(MPI_COMM_WORLD, &world_grp);
+    SMGC_MPICHK(mpi_ret_code, out);
+    mpi_ret_code = MPI_Group_range_incl(world_grp, 1, range, &even_grp);
+    SMGC_MPICHK(mpi_ret_code, out);
 
-    for (i = 0; i < num_fs_test_paths; ++i) {
-        int nw = snprintf(path_buff, SMGC_PATH_MAX, "%s/%s", fs_test_list[i],
-                          SMGC_MPI_FILE_NAME);
-        if (nw >= SMGC_PATH_MAX) return SMGC_ERROR;
+    SMGC_MPF("       communicators per constructor: %d (all kept alive)\n",
+             SMGC_CC_NUM_ITRS);
+    if (vm_rss_kb() < 0) {
+        SMGC_MPF("       resident memory size not available\n");
+    }
+    SMGC_MPF("       %-26s %10s %10s %10s %10s %10s  %s\n", "constructor",
+             "min us", "median us", "max us", "ave kB", "max kB",
+             "max rank");
 
-        SMGC_MPF("   === mpi_comm_world: writing to %s\n", fs_test_list[i]);
+    wd_op = wd_op_begin("comm_create", 0);
 
-        /* barrier before we start each iteration */
+    for (op = 0; op < SMGC_NUM_CCS; ++op) {
+        wd_op_step(wd_op, op, -1, -1);
         mpi_ret_code = MPI_Barrier(MPI_COMM_WORLD);
         SMGC_MPICHK(mpi_ret_code, out);
 
-        effe_start = MPI_Wtime();
-        mpi_ret_code = MPI_File_open(MPI_COMM_WORLD, path_buff, amode,
-                                     MPI_INFO_NULL, &mpi_fh);
-        SMGC_MPICHK(mpi_ret_code, out);
-
-        mpi_ret_code = MPI_File_set_view(mpi_fh, (MPI_Offset)0, MPI_CHAR,
-                                         MPI_CHAR, "native", MPI_INFO_NULL);
-        SMGC_MPICHK(mpi_ret_code, out);
-
-        write_start = MPI_Wtime();
-        mpi_ret_code = MPI_File_write_at(mpi_fh, offset, buff,
-                                         file_size, MPI_CHAR,
-                                         &status);
-        SMGC_MPICHK(mpi_ret_code, out);
-        write_fin = MPI_Wtime();
-
-        gete_start = MPI_Wtime();
-        mpi_ret_code = MPI_Get_elements(&status, MPI_CHAR, &num_elems);
-        SMGC_MPICHK(mpi_ret_code, out);
-        gete_fin = MPI_Wtime();
-
-        if ((sizeof(char) * file_size) != (size_t)num_elems) {
-            SMGC_ERR_MSG("write size mismatch.  wrote %lu requested %d\n",
-                         sizeof(char) * file_size,
-                         num_elems);
-            goto out;
+        rss = vm_rss_kb();
+        for (k = 0, n = 0; k < SMGC_CC_NUM_ITRS; ++k) {
+            t = MPI_Wtime();
+            if (SMGC_SUCCESS != cc_create(op, even_grp, &comms[k])) {
+                goto out;
+            }
+            t = MPI_Wtime() - t;
+            if (SMGC_CC_CREATE_GROUP != op || 0 == my_rank % 2) {
+                times[n++] = t * 1e6;
+            }
         }
+        rss_after = vm_rss_kb();
+        kb = (rss < 0 || rss_after < 0 || 0 == n) ? -1.0 :
+             (double)(rss_after - rss) / SMGC_CC_NUM_ITRS;
 
-        read_start = MPI_Wtime();
-        mpi_ret_code = MPI_File_read_at(mpi_fh, offset, buff, file_size,
-                                        MPI_CHAR, &status);
-        SMGC_MPICHK(mpi_ret_code, out);
-        read_fin = MPI_Wtime();
-
-        gete_start2 = MPI_Wtime();
-        mpi_ret_code = MPI_Get_elements(&status, MPI_CHAR, &num_elems);
-        SMGC_MPICHK(mpi_ret_code, out);
-        gete_fin2 = MPI_Wtime();
-
-        mpi_ret_code = MPI_File_close(&mpi_fh);
-        SMGC_MPICHK(mpi_ret_code, out);
-        effe_fin = MPI_Wtime();
+        for (k = 0; k < SMGC_CC_NUM_ITRS; ++k) {
+            if (MPI_COMM_NULL != comms[k]) {
+                mpi_ret_code = MPI_Comm_free(&comms[k]);
+                SMGC_MPICHK(mpi_ret_code, out);
+            }
+        }
 
-        if ((sizeof(char) * file_size) != (size_t)num_elems) {
-            SMGC_ERR_MSG("write/read mismatch.  wrote %lu read %d\n",
-                         sizeof(char) * file_size,
-                         num_elems);
+        qsort(times, n, sizeof(double), qsort_cmp_dbl);
+        if (SMGC_SUCCESS != cc_row(cc_names[op], n, times, kb)) {
             goto out;
         }
+    }
 
-        /* subtract time not spent in benchmarked routines */
-        effe_bw_time_fix = (gete_fin - gete_start) +
-                           (gete_fin2 - gete_start2);
+    wd_op_end(wd_op);
+    wd_op = NULL;
 
-        /* calculate bandwidths */
+    rc = SMGC_SUCCESS;
+out:
+    wd_op_end(wd_op);
+    for (k = 0; k < SMGC_CC_NUM_ITRS; ++k) {
+        if (MPI_COMM_NULL != comms[k]) MPI_Comm_free(&comms[k]);
+    }
+    if (MPI_GROUP_NULL != even_grp) MPI_Group_free(&even_grp);
+    if (MPI_GROUP_NULL != world_grp) MPI_Group_free(&world_grp);
+    return rc;
+}
 
-        /* negative and 0 length file size protection provided by lower level */
-        /* zero value fixup - good enough for our purposes */
+/* ////////////////////////////////////////////////////////////////////////// */
+/**
+ * one match_stress round between this rank and partner: builds a queue of
+ * depth messages of kind mode at the receiver (recv) and sets *t to the time
+ * (s) the receiver needs to match them all. every message carries its tag,
+ * so mismatches are caught. vals and reqs hold depth elements.
+ */
+static int
+match_round(int mode, int depth, int partner, bool recv, int *vals,
+            MPI_Request *reqs, double *t)
+{
+    int k = 0, got = 0, tag = 0, rc = SMGC_ERROR;
+    int src = (SMGC_MATCH_UNEXP_ANY_SRC == mode ||
+               SMGC_MATCH_POSTED_ANY_SRC == mode) ? MPI_ANY_SOURCE : partner;
+    bool posted = (SMGC_MATCH_POSTED == mode ||
+                   SMGC_MATCH_POSTED_ANY_SRC == mode);
+    MPI_Status status;
 
-        /* effective bandwidth */
-        if (0.0 >= (tmp_dbl = ((effe_fin - effe_start) - effe_bw_time_fix))) {
-            effe_bw = 0.0;
+    *t = 0.0;
+
+    if (!recv) {
+        /* unexpected: the queue first, then the handshake. posted: the other
+         * way around, newest tag first - so every message walks the queue
+         */
+        if (posted) {
+            mpi_ret_code = MPI_Recv(NULL, 0, MPI_BYTE, partner,
+                                    SMGC_MATCH_SYNC_TAG, MPI_COMM_WORLD,
+                                    MPI_STATUS_IGNORE);
+            SMGC_MPICHK(mpi_ret_code, out);
         }
-        else {
-            effe_bw = ((double)file_size / tmp_dbl / (double)SMGC_MB_SIZE);
+        for (k = 0; k < depth; ++k) {
+            tag = posted ? (depth - 1 - k) : k;
+            vals[k] = tag;
+            mpi_ret_code = MPI_Isend(&vals[k], 1, MPI_INT, partner, tag,
+                                     MPI_COMM_WORLD, &reqs[k]);
+            SMGC_MPICHK(mpi_ret_code, out);
         }
-        /* write bandwidth */
-        if (0.0 >= (tmp_dbl = (write_fin - write_start))) {
-            write_bw = 0.0;
+        if (!posted) {
+            mpi_ret_code = MPI_Send(NULL, 0, MPI_BYTE, partner,
+                                    SMGC_MATCH_SYNC_TAG, MPI_COMM_WORLD);
+            SMGC_MPICHK(mpi_ret_code, out);
         }
-        else {
-            write_bw = ((double)file_size / tmp_dbl / (double)SMGC_MB_SIZE);
+        mpi_ret_code = MPI_Waitall(depth, reqs, MPI_STATUSES_IGNORE);
+        SMGC_MPICHK(mpi_ret_code, out);
+        return SMGC_SUCCESS;
+    }
+
+    if (posted) {
+        for (k = 0; k < depth; ++k) {
+            vals[k] = -1;
+            mpi_ret_code = MPI_Irecv(&vals[k], 1, MPI_INT, src, k,
+                                     MPI_COMM_WORLD, &reqs[k]);
+            SMGC_MPICHK(mpi_ret_code, out);
         }
-        /* read bandwidth */
-        if (0.0 >= (tmp_dbl = (read_fin - read_start))) {
-            read_bw = 0.0;
+        mpi_ret_code = MPI_Send(NULL, 0, MPI_BYTE, partner,
+                                SMGC_MATCH_SYNC_TAG, MPI_COMM_WORLD);
+        SMGC_MPICHK(mpi_ret_code, out);
+        *t = MPI_Wtime();
+        mpi_ret_code = MPI_Waitall(depth, reqs, MPI_STATUSES_IGNORE);
+        SMGC_MPICHK(mpi_ret_code, out);
+        *t = MPI_Wtime() - *t;
+        for (k = 0; k < depth; ++k) {
+            if (k != vals[k]) {
+                got = vals[k];
+                tag = k;
+                goto mismatch;
+            }
+        }
+        return SMGC_SUCCESS;
+    }
+
+    /* messages from one sender arrive in order, so the whole queue is in */
+    mpi_ret_code = MPI_Recv(NULL, 0, MPI_BYTE, partner, SMGC_MATCH_SYNC_TAG,
+                            MPI_COMM_WORLD, MPI_STATUS_IGNORE);
+    SMGC_MPICHK(mpi_ret_code, out);
+    *t = MPI_Wtime();
+    for (k = 0; k < depth; ++k) {
+        if (SMGC_MATCH_UNEXP_ANY_TAG == mode) {
+            /* takes the head of the queue */
+            mpi_ret_code = MPI_Recv(&got, 1, MPI_INT, partner, MPI_ANY_TAG,
+                                    MPI_COMM_WORLD, &status);
+            tag = k;
         }
         else {
-            read_bw = ((double)file_size / tmp_dbl / (double)SMGC_MB_SIZE);
+            /* newest first - every receive walks the queue */
+            tag = depth - 1 - k;
+            mpi_ret_code = MPI_Recv(&got, 1, MPI_INT, src, tag,
+                                    MPI_COMM_WORLD, &status);
+        }
+        SMGC_MPICHK(mpi_ret_code, out);
+        if (got != tag || status.MPI_TAG != tag) {
+            goto mismatch;
         }
+    }
+    *t = MPI_Wtime() - *t;
+    return SMGC_SUCCESS;
 
-        /* fill structs for calculating min/max */
-        in_effe.val = effe_bw;
-        in_effe.rank = my_rank;
-        in_wr.val = write_bw;
-        in_wr.rank = my_rank;
-        in_rd.val = read_bw;
-        in_rd.rank = my_rank;
+mismatch:
+    SMGC_ERR_MSG("%s: rank %d (%s) expected tag %d from rank %d, got %d\n",
+                 match_names[mode], my_rank, host_name_buff, tag, partner,
+                 got);
+    rc = SMGC_ERROR;
+out:
+    return rc;
+}
 
-        /* calculate effective bandwidth stats */
-        if (SMGC_SUCCESS != io_stats(in_effe, "effective write bandwidth",
-                                     IO_STATS_MBS)) {
-            goto out;
+/* ////////////////////////////////////////////////////////////////////////// */
+/**
+ * message matching under load. every rank and its peer (see:
+ * msg_rate_partner) take turns building queues of SMGC_MATCH_MIN_DEPTH to
+ * match_depth small messages at the receiver: unexpected messages received
+ * newest first with a specific and an any source receive or head first with
+ * any tag, and posted receives (specific or any source) that the sender
+ * satisfies newest first. one row per queue and depth: receives matched per
+ * second. the deepest queues are also reported per node, with the nodes
+ * that fall well short of the median.
+ */
+static int
+match_stress(void)
+{
+    int mode = 0, depth = 0, role = 0, step = 0, partner = -1;
+    int rc = SMGC_ERROR, *vals = NULL;
+    bool is_leader = (MPI_COMM_NULL != tiers[2].comm);
+    char label[64];
+    double t = 0.0, rate = -1.0, rank_rate = 0.0, node_rate = 0.0;
+    MPI_Request *reqs = NULL;
+    smgc_wd_op_t *wd_op = NULL;
+
+    if (num_ranks < 2) {
+        SMGC_MPF("       at least 2 ranks are required - skipping\n");
+        return SMGC_SUCCESS;
+    }
+
+    if (SMGC_SUCCESS != msg_rate_partner(&partner)) {
+        goto out;
+    }
+    vals = (int *)malloc(match_depth * sizeof(int));
+    SMGC_MEMCHK(vals, out);
+    reqs = (MPI_Request *)malloc(match_depth * sizeof(MPI_Request));
+    SMGC_MEMCHK(reqs, out);
+
+    SMGC_MPF("       queue depths: %d to %d (x%d)\n", SMGC_MATCH_MIN_DEPTH,
+             match_depth, SMGC_MATCH_DEPTH_FACTOR);
+    SMGC_MPF("       pairing: %s\n", (num_nodes < 2) ?
+             "halves of a single node (intra-node)" :
+             "node 2i with node 2i + 1 (inter-node)");
+    SMGC_MPF("       %-26s %10s %10s %10s %12s  %s\n", "matched (Mmsg/s)",
+             "min", "ave", "max", "aggregate", "min rank");
+
+    wd_op = wd_op_begin("match_stress", 0);
+
+    for (mode = 0; mode < SMGC_NUM_MATCH_MODES; ++mode) {
+        for (depth = SMGC_MATCH_MIN_DEPTH; ; depth *= SMGC_MATCH_DEPTH_FACTOR) {
+            /* always end on the deepest queue */
+            if (depth > match_depth) {
+                depth = match_depth;
+            }
+            wd_op_step(wd_op, step++, partner, partner);
+            rate = -1.0;
+            /* the lower rank of a pair receives first */
+            for (role = 0; role < 2 && partner >= 0; ++role) {
+                if (SMGC_SUCCESS != match_round(mode, depth, partner,
+                                                (0 == role) ==
+                                                (my_rank < partner),
+                                                vals, reqs, &t)) {
+                    goto out;
+                }
+                if (t > 0.0) {
+                    rate = (double)depth / t / 1e6;
+                }
+            }
+            snprintf(label, sizeof(label), "%s %d", match_names[mode], depth);
+            if (SMGC_SUCCESS != rate_row_stats(label, rate)) {
+                goto out;
+            }
+            if (depth >= match_depth) {
+                break;
+            }
         }
-        /* calculate write bandwidth stats */
-        if (SMGC_SUCCESS != io_stats(in_wr, "pure write bandwidth",
-                                     IO_STATS_MBS)) {
+
+        /* a node's rate is the sum over its ranks */
+        rank_rate = (rate < 0.0) ? 0.0 : rate;
+        mpi_ret_code = MPI_Reduce(&rank_rate, &node_rate, 1, MPI_DOUBLE,
+                                  MPI_SUM, 0, tiers[1].comm);
+        SMGC_MPICHK(mpi_ret_code, out);
+        if (rate < 0.0) {
+            node_rate = -1.0;
+        }
+        snprintf(label, sizeof(label), "%s %d node", match_names[mode],
+                 depth);
+        if (SMGC_SUCCESS != rate_row_stats(label, is_leader ? node_rate :
+                                                              -1.0)) {
             goto out;
         }
-        /* calculate read bandwidth stats */
-        if (SMGC_SUCCESS != io_stats(in_rd, "pure read bandwidth",
-                                     IO_STATS_MBS)) {
+        if (num_nodes > 1 && is_leader &&
+            SMGC_SUCCESS != msg_rate_slow_nodes(node_rate)) {
             goto out;
         }
     }
 
-    /* all is well, set rc accordingly */
+    wd_op_end(wd_op);
+    wd_op = NULL;
+
     rc = SMGC_SUCCESS;
 out:
-    if (NULL != buff) free(buff);
+    wd_op_end(wd_op);
+    if (NULL != reqs) free(reqs);
+    if (NULL != vals) free(vals);
     return rc;
 }
 
-#if 0
 /* ////////////////////////////////////////////////////////////////////////// */
+/**
+ * times len B ping-pongs between the two ranks of pp and sets *lat to the
+ * one-way latency (us) of the fastest of SMGC_PROTO_NUM_BATCHES batches.
+ * rank 0 of the pair times, but both ranks return its result so that both
+ * take the same path through the sweep.
+ */
 static int
-host_info_exchange(void)
+proto_pingpong(smgc_pp_t *pp, int len, double *lat)
 {
-    unsigned long int *net_nums = (unsigned long int *)
-                                  calloc(num_ranks, sizeof(unsigned long int));
-    int rc = SMGC_ERROR;
+    int b = 0, k = 0, tag = 42, peer = 1 - pp->rank, rc = SMGC_ERROR;
+    double t = 0.0, best = DBL_MAX;
 
-    if (NULL == net_nums) {
-        SMGC_ERR_MSG("out of resources\n");
-        return SMGC_ERROR;
+    wd_op_step(pp->wd_op, pp->iter, pp->peer_w, pp->peer_w);
+    if (0 == pp->rank) {
+        payload_prep(pp->sbuf, len, my_rank, pp->peer_w, pp->iter);
     }
-    if (SMGC_SUCCESS != get_my_global_color(true, &my_color)) {
-        SMGC_ERR_MSG("get_my_global_color failure\n");
+    /* batch 0 warms up the path at this size and is not timed */
+    for (b = 0; b <= SMGC_PROTO_NUM_BATCHES; ++b) {
+        t = MPI_Wtime();
+        for (k = 0; k < SMGC_PROTO_NUM_ITRS; ++k) {
+            if (0 == pp->rank) {
+                mpi_ret_code = MPI_Send(pp->sbuf, len, MPI_CHAR, peer, tag,
+                                        pp->comm);
+                SMGC_MPICHK(mpi_ret_code, out);
+                mpi_ret_code = MPI_Recv(pp->rbuf, len, MPI_CHAR, peer, tag,
+                                        pp->comm, MPI_STATUS_IGNORE);
+                SMGC_MPICHK(mpi_ret_code, out);
+            }
+            else {
+                mpi_ret_code = MPI_Recv(pp->rbuf, len, MPI_CHAR, peer, tag,
+                                        pp->comm, MPI_STATUS_IGNORE);
+                SMGC_MPICHK(mpi_ret_code, out);
+                mpi_ret_code = MPI_Send(pp->rbuf, len, MPI_CHAR, peer, tag,
+                                        pp->comm);
+                SMGC_MPICHK(mpi_ret_code, out);
+            }
+        }
+        t = MPI_Wtime() - t;
+        if (b > 0 && t < best) {
+            best = t;
+        }
+    }
+    /* the echo must still be what was sent */
+    if (0 == pp->rank &&
+        SMGC_SUCCESS != payload_verify(pp->rbuf, len, my_rank, pp->peer_w,
+                                       pp->iter)) {
         goto out;
     }
+    ++pp->iter;
+
+    *lat = best * 1e6 / (2.0 * SMGC_PROTO_NUM_ITRS);
+    mpi_ret_code = MPI_Bcast(lat, 1, MPI_DOUBLE, 0, pp->comm);
+    SMGC_MPICHK(mpi_ret_code, out);
 
+    rc = SMGC_SUCCESS;
 out:
-    if (NULL != net_nums) free(net_nums);
     return rc;
 }
-#endif
 
 /* ////////////////////////////////////////////////////////////////////////// */
+/**
+ * classifies the step from lo B at lo_lat us to hi B at hi_lat us, given
+ * that latency is expected to grow by slope us/B: 1 if it costs more than
+ * that, -1 if it gets faster, 0 if the change is within noise.
+ */
 static int
-hostname_exchange(void)
+proto_switch(int lo, double lo_lat, int hi, double hi_lat, double slope)
 {
-    int buff_size = num_ranks * SMGC_HOST_NAME_MAX * sizeof(char);
-    if (NULL == rhname_lut_ptr) {
-        rhname_lut_ptr = (char *)calloc(buff_size, sizeof(char));
-        SMGC_MEMCHK(rhname_lut_ptr, error);
-    }
-
-    memset(rhname_lut_ptr, '\0', buff_size);
-
-    SMGC_MPF("       mpi_comm_world: mpi_allgather buffer size: %d B\n",
-             buff_size);
-    SMGC_MPF("       mpi_comm_world: exchanging host name information\n");
-
-    /* populate the remote host name lookup table */
-    mpi_ret_code = MPI_Allgather(host_name_buff, SMGC_HOST_NAME_MAX, MPI_CHAR,
-                                 rhname_lut_ptr, SMGC_HOST_NAME_MAX, MPI_CHAR,
-                                 MPI_COMM_WORLD);
-    SMGC_MPICHK(mpi_ret_code, error);
+    double grown = lo_lat + (double)(hi - lo) * slope;
 
-    return SMGC_SUCCESS;
-error:
-    /* only free rhname_lut_ptr in error condition */
-    if (NULL != rhname_lut_ptr) {
-        free(rhname_lut_ptr);
-        rhname_lut_ptr = NULL;
+    if (hi_lat > grown * (1.0 + SMGC_PROTO_JUMP_FRAC) &&
+        hi_lat - grown > SMGC_PROTO_MIN_US) {
+        return 1;
     }
-    return SMGC_ERROR;
+    if (hi_lat < lo_lat * (1.0 - SMGC_PROTO_JUMP_FRAC) &&
+        lo_lat - hi_lat > SMGC_PROTO_MIN_US) {
+        return -1;
+    }
+    return 0;
 }
 
 /* ////////////////////////////////////////////////////////////////////////// */
+/**
+ * times both sizes of switch sw again, keeping the faster times, and returns
+ * whether the switch persists in *held.
+ */
 static int
-small_allreduce_max(void)
+proto_retime(smgc_pp_t *pp, smgc_proto_sw_t *sw, bool *held)
 {
-    double send_buff = (double)my_rank, recv_buff = 0.0;
-
-    SMGC_MPF("       message size: %d B\n", (int)sizeof(double));
-    SMGC_MPF("       mpi_comm_world: mpi_allreducing\n");
-
-    mpi_ret_code = MPI_Allreduce(&send_buff, &recv_buff, 1, MPI_DOUBLE,
-                                 MPI_MAX, MPI_COMM_WORLD);
-    SMGC_MPICHK(mpi_ret_code, error);
-
-    SMGC_MPF("       mpi_comm_world: verifying result\n");
+    double lo_lat = 0.0, hi_lat = 0.0;
 
-    /* yes, i do want to do it this way :-) */
-    if (recv_buff != (double)(num_ranks - 1)) {
-        SMGC_ERR_MSG("invalid result detected\n");
-        goto error;
+    if (SMGC_SUCCESS != proto_pingpong(pp, sw->lo, &lo_lat) ||
+        SMGC_SUCCESS != proto_pingpong(pp, sw->hi, &hi_lat)) {
+        return SMGC_ERROR;
     }
-
+    if (lo_lat < sw->lo_lat) sw->lo_lat = lo_lat;
+    if (hi_lat < sw->hi_lat) sw->hi_lat = hi_lat;
+    *held = (proto_switch(sw->lo, sw->lo_lat, sw->hi, sw->hi_lat,
+                          sw->slope) == sw->dir);
     return SMGC_SUCCESS;
-error:
-    return SMGC_ERROR;
 }
 
 /* ////////////////////////////////////////////////////////////////////////// */
 /**
- * potentially a very synchronous all to root point-to-point implementation.
+ * confirms switch sw (sw->dir is set to 0 if it was noise) and narrows it
+ * down to adjacent sizes by bisection. should noise throw bisection off, sw
+ * keeps the sizes it started with.
  */
 static int
-large_all_to_root_ptp(void)
+proto_bisect(smgc_pp_t *pp, smgc_proto_sw_t *sw)
 {
-    int buff_size   = msg_size;
-    int src_rank    = 0, tag = 0;
-    int rc          = SMGC_ERROR;
-    char *char_buff = NULL;
-    char *del       = "\b\b\b\b\b\b\b\b\b\b\b\b\b";
-    MPI_Status status;
+    int mid = 0;
+    bool held = false;
+    double mid_lat = 0.0;
+    smgc_proto_sw_t orig;
 
-    if (NULL == (char_buff = (char *)calloc(buff_size, sizeof(char)))) {
-        SMGC_ERR_MSG("out of resources\n");
+    if (SMGC_SUCCESS != proto_retime(pp, sw, &held)) {
+        return SMGC_ERROR;
+    }
+    if (!held) {
+        sw->dir = 0;
+        return SMGC_SUCCESS;
+    }
+    orig = *sw;
+    while (sw->hi - sw->lo > 1) {
+        mid = sw->lo + (sw->hi - sw->lo) / 2;
+        if (SMGC_SUCCESS != proto_pingpong(pp, mid, &mid_lat)) {
+            return SMGC_ERROR;
+        }
+        /* mid already switched if the switch shows up before it */
+        if (proto_switch(sw->lo, sw->lo_lat, mid, mid_lat,
+                         sw->slope) == sw->dir) {
+            sw->hi = mid;
+            sw->hi_lat = mid_lat;
+        }
+        else {
+            sw->lo = mid;
+            sw->lo_lat = mid_lat;
+        }
+    }
+    if (SMGC_SUCCESS != proto_retime(pp, sw, &held)) {
         return SMGC_ERROR;
     }
+    if (!held) {
+        *sw = orig;
+    }
+    return SMGC_SUCCESS;
+}
+
+/* ////////////////////////////////////////////////////////////////////////// */
+/**
+ * the proto_thresholds sweep over pair: tier rank 0 (the master) and tier
+ * rank 1 of tier. the master reports what it finds.
+ */
+static int
+proto_tier(const smgc_tier_t *tier, MPI_Comm pair)
+{
+    int i = 0, j = 0, n = 0, len = 0, nsw = 0, rc = SMGC_ERROR;
+    int *lens = NULL;
+    int eager = -1, rndv = -1, pipe = -1;
+    double *lats = NULL, lat = 0.0, slope = 0.0;
+    const char *proto = NULL;
+    smgc_proto_sw_t sw[SMGC_PROTO_MAX_SWITCHES];
+    smgc_pp_t pp;
+
+    memset(&pp, 0, sizeof(pp));
+    pp.comm = pair;
+    mpi_ret_code = MPI_Comm_rank(pair, &pp.rank);
+    SMGC_MPICHK(mpi_ret_code, out);
+    pp.peer_w = tier_wrank(tier, 1 - tier->rank);
+    pp.sbuf = (char *)arena_get(SMGC_PROTO_MAX_SIZE);
+    SMGC_MEMCHK(pp.sbuf, out);
+    pp.rbuf = (char *)arena_get(SMGC_PROTO_MAX_SIZE);
+    SMGC_MEMCHK(pp.rbuf, out);
+
+    /* SMGC_PROTO_STEPS even steps per doubling, powers of two included */
+    for (len = 1; len <= SMGC_PROTO_MAX_SIZE; len *= 2) {
+        n += SMGC_PROTO_STEPS;
+    }
+    lens = (int *)malloc(n * sizeof(int));
+    SMGC_MEMCHK(lens, out);
+    lats = (double *)malloc(n * sizeof(double));
+    SMGC_MEMCHK(lats, out);
+    for (n = 0, len = 1; len <= SMGC_PROTO_MAX_SIZE; len *= 2) {
+        for (j = 0; j < SMGC_PROTO_STEPS; ++j) {
+            i = len + (int)((long)len * j / SMGC_PROTO_STEPS);
+            if (i > SMGC_PROTO_MAX_SIZE) {
+                break;
+            }
+            if (0 == n || i > lens[n - 1]) {
+                lens[n++] = i;
+            }
+        }
+    }
 
-    SMGC_MPF("       message size: %d B\n", buff_size);
+    SMGC_MPF("       %s: %06d (%s) <==> %06d (%s)\n", tier->name,
+             my_rank, host_name_buff, pp.peer_w, get_rhn(pp.peer_w));
 
-    /* if we are here, let the games begin */
+    pp.wd_op = wd_op_begin("proto_thresholds", 0);
 
-    if (SMGC_MASTER_RANK != my_rank) {
-        mpi_ret_code = MPI_Send(char_buff, buff_size, MPI_CHAR,
-                                SMGC_MASTER_RANK, tag, MPI_COMM_WORLD);
-        SMGC_MPICHK(mpi_ret_code, out);
+    /* interference only ever adds latency, and it comes in bursts - so the
+     * fastest of a few sweeps is kept.
+     */
+    for (j = 0; j < SMGC_PROTO_NUM_SWEEPS; ++j) {
+        for (i = 0; i < n; ++i) {
+            if (SMGC_SUCCESS != proto_pingpong(&pp, lens[i], &lat)) {
+                goto out;
+            }
+            if (0 == j || lat < lats[i]) {
+                lats[i] = lat;
+            }
+        }
     }
-    /* i am the root */
-    else {
-        SMGC_MPF("       mpi_comm_world: mpi_sending to rank %d - ",
-                 SMGC_MASTER_RANK);
-        for (src_rank = 0; src_rank < num_ranks; ++src_rank) {
-            if (my_rank != src_rank) {
-                SMGC_MPF("%s%06d/%06d%s", 1 == src_rank ? "" : del, src_rank,
-                         (num_ranks - 1),
-                         (num_ranks  -1) == src_rank ? "\n" : "");
-
-                mpi_ret_code = MPI_Recv(char_buff, buff_size, MPI_CHAR,
-                                        src_rank, tag, MPI_COMM_WORLD, &status);
-                SMGC_MPICHK(mpi_ret_code, out);
+    for (i = 1; i < n && nsw < SMGC_PROTO_MAX_SWITCHES; ++i) {
+        /* without a switch, latency grows like it does on either side. a
+         * steeper slope on one side (a cache running out, say) is fine.
+         */
+        sw[nsw].slope = 0.0;
+        for (j = i - 1; j <= i + 1; j += 2) {
+            if (j >= 1 && j < n) {
+                slope = (lats[j] - lats[j - 1]) / (lens[j] - lens[j - 1]);
+                if (slope > sw[nsw].slope) {
+                    sw[nsw].slope = slope;
+                }
             }
         }
+        sw[nsw].dir = proto_switch(lens[i - 1], lats[i - 1], lens[i],
+                                   lats[i], sw[nsw].slope);
+        if (0 == sw[nsw].dir) {
+            continue;
+        }
+        sw[nsw].lo = lens[i - 1];
+        sw[nsw].hi = lens[i];
+        sw[nsw].lo_lat = lats[i - 1];
+        sw[nsw].hi_lat = lats[i];
+        if (SMGC_SUCCESS != proto_bisect(&pp, &sw[nsw])) {
+            goto out;
+        }
+        if (0 != sw[nsw].dir) {
+            ++nsw;
+        }
     }
-    /* we made it - rainbows and butterflies */
+
+    wd_op_end(pp.wd_op);
+    pp.wd_op = NULL;
+
+    /* the first jump is taken as eager to rendezvous, the next switch (either
+     * way) as the start of pipelining.
+     */
+    for (i = 0; i < nsw; ++i) {
+        SMGC_MPF("          switch: %d B (%.3f %s) ==> %d B (%.3f %s): "
+                 "%+.0f%%\n", sw[i].lo, sw[i].lo_lat, SMGC_TIME_US_UNIT_STR,
+                 sw[i].hi, sw[i].hi_lat, SMGC_TIME_US_UNIT_STR,
+                 (sw[i].hi_lat / sw[i].lo_lat - 1.0) * 100.0);
+        if (rndv < 0 && sw[i].dir > 0) {
+            eager = sw[i].lo;
+            rndv = sw[i].hi;
+        }
+        else if (rndv > 0 && pipe < 0) {
+            pipe = sw[i].hi;
+        }
+    }
+    if (0 == nsw) {
+        SMGC_MPF("          no protocol switches detected\n");
+    }
+    if (rndv > 0) {
+        SMGC_MPF("          eager limit: %d B\n", eager);
+        SMGC_MPF("          rendezvous from: %d B\n", rndv);
+    }
+    else {
+        SMGC_MPF("          eager limit: not detected (>= %d B)\n",
+                 lens[n - 1]);
+    }
+    if (pipe > 0) {
+        SMGC_MPF("          pipelining from: %d B\n", pipe);
+    }
+    else {
+        SMGC_MPF("          pipelining from: not detected\n");
+    }
+    /* where the message size in use lands */
+    if (rndv < 0 || msg_size <= (size_t)eager) {
+        proto = "eager";
+    }
+    else if (pipe > 0 && msg_size >= (size_t)pipe) {
+        proto = "pipelined";
+    }
+    else {
+        proto = "rendezvous";
+    }
+    SMGC_MPF("          message size (%lu B): %s\n", (unsigned long)msg_size,
+             proto);
+
     rc = SMGC_SUCCESS;
 out:
-    if (NULL != char_buff) {
-        free(char_buff);
-    }
+    wd_op_end(pp.wd_op);
+    if (NULL != lats) free(lats);
+    if (NULL != lens) free(lens);
     return rc;
 }
 
 /* ////////////////////////////////////////////////////////////////////////// */
+/**
+ * finds where the mpi library switches point-to-point protocols: a fine
+ * ping-pong size sweep within the master's node and between the master's
+ * node and the next one. jumps and drops in latency that bandwidth does not
+ * explain are protocol switches - eager to rendezvous first, then pipelining.
+ */
 static int
-root_bcast(void)
+proto_thresholds(void)
 {
-    int buff_size = msg_size, rc = SMGC_ERROR;
-    char *char_buff = NULL;
-
-    if (NULL == (char_buff = (char *)calloc(buff_size, sizeof(char)))) {
-        SMGC_ERR_MSG("out of resources\n");
-        return SMGC_ERROR;
+    int t = 0, rc = SMGC_ERROR;
+    const smgc_tier_t *tier = NULL;
+    bool in_pair = false;
+    MPI_Comm pair = MPI_COMM_NULL;
+
+    SMGC_MPF("       sizes: 1 B to %d B (%d per doubling)\n",
+             SMGC_PROTO_MAX_SIZE, SMGC_PROTO_STEPS);
+    SMGC_MPF("       latency: best of %d sweeps x %d batches of %d round "
+             "trips\n", SMGC_PROTO_NUM_SWEEPS, SMGC_PROTO_NUM_BATCHES,
+             SMGC_PROTO_NUM_ITRS);
+
+    for (t = 1; t < SMGC_NUM_TIERS; ++t) {
+        tier = &tiers[t];
+        /* tier ranks 0 and 1 of the master's instance of the tier */
+        in_pair = (MPI_COMM_NULL != tier->comm && tier->size > 1 &&
+                   tier->rank < 2 &&
+                   SMGC_MASTER_RANK == tier_wrank(tier, 0));
+        if (!in_pair) {
+            SMGC_MPF("       %s: fewer than 2 ranks - skipping\n",
+                     tier->name);
+        }
+        mpi_ret_code = MPI_Comm_split(MPI_COMM_WORLD,
+                                      in_pair ? 0 : MPI_UNDEFINED, my_rank,
+                                      &pair);
+        SMGC_MPICHK(mpi_ret_code, out);
+        arena_reset();
+        if (MPI_COMM_NULL != pair) {
+            if (SMGC_SUCCESS != proto_tier(tier, pair)) {
+                goto out;
+            }
+            MPI_Comm_free(&pair);
+        }
+    }
+    if (SMGC_SUCCESS != payload_verify_stats(MPI_COMM_WORLD)) {
+        goto out;
     }
 
-    SMGC_MPF("       message size: %d B\n", buff_size);
-    SMGC_MPF("       rank %06d (%s): broadcasting to mpi_comm_world\n", my_rank,
-             host_name_buff);
-
-    mpi_ret_code = MPI_Bcast(char_buff, buff_size, MPI_CHAR, SMGC_MASTER_RANK,
-                             MPI_COMM_WORLD);
-    SMGC_MPICHK(mpi_ret_code, out);
-
-    /* if we are here, then all is well - note that fact */
     rc = SMGC_SUCCESS;
 out:
-    if (NULL != char_buff) {
-        free(char_buff);
-        char_buff = NULL;
-    }
+    if (MPI_COMM_NULL != pair) MPI_Comm_free(&pair);
     return rc;
 }
 
 /* ////////////////////////////////////////////////////////////////////////// */
+/**
+ * builds (and commits) datatype dt over a layout of nblk dt_block B blocks
+ * spaced 2 * dt_block B apart and describes the bytes it covers as *npieces
+ * (offset, length) pieces - at most 2 * nblk. perm orders indexed blocks.
+ */
 static int
-rand_root_bcast(void)
+dt_build(int dt, int nblk, const int *perm, MPI_Datatype *type, size_t *offs,
+         size_t *lens, int *npieces)
 {
-    int i = 0, buff_size = msg_size, num_itrs = 8, next_bc_root = 0,
-        rc = SMGC_ERROR;
-    char *char_buff = NULL;
-
-    if (NULL == (char_buff = (char *)calloc(buff_size, sizeof(char)))) {
-        SMGC_ERR_MSG("out of resources\n");
-        return SMGC_ERROR;
+    int i = 0, n = 0, blk = dt_block / (int)sizeof(double), rc = SMGC_ERROR;
+    int sizes[2], subsizes[2], starts[2], blens[2] = {blk, 1};
+    int *displs = NULL;
+    size_t stride = 2 * (size_t)dt_block;
+    MPI_Aint sdispls[2] = {0, dt_block};
+    MPI_Datatype stypes[2] = {MPI_DOUBLE, MPI_INT};
+    MPI_Datatype tmp = MPI_DATATYPE_NULL, elem = MPI_DATATYPE_NULL;
+
+    switch (dt) {
+        case SMGC_DT_CONTIG:
+            mpi_ret_code = MPI_Type_contiguous(nblk * blk, MPI_DOUBLE, type);
+            SMGC_MPICHK(mpi_ret_code, out);
+            offs[n] = 0;
+            lens[n++] = (size_t)nblk * dt_block;
+            break;
+        case SMGC_DT_VECTOR:
+            mpi_ret_code = MPI_Type_vector(nblk, blk, 2 * blk, MPI_DOUBLE,
+                                           type);
+            SMGC_MPICHK(mpi_ret_code, out);
+            for (i = 0; i < nblk; ++i) {
+                offs[n] = i * stride;
+                lens[n++] = dt_block;
+            }
+            break;
+        case SMGC_DT_SUBARRAY:
+            /* the middle half of every row of an nblk x 2 blk array */
+            sizes[0] = subsizes[0] = nblk;
+            sizes[1] = 2 * blk;
+            subsizes[1] = blk;
+            starts[0] = 0;
+            starts[1] = blk / 2;
+            mpi_ret_code = MPI_Type_create_subarray(2, sizes, subsizes, starts,
+                                                    MPI_ORDER_C, MPI_DOUBLE,
+                                                    type);
+            SMGC_MPICHK(mpi_ret_code, out);
+            for (i = 0; i < nblk; ++i) {
+                offs[n] = i * stride + (blk / 2) * sizeof(double);
+                lens[n++] = dt_block;
+            }
+            break;
+        case SMGC_DT_INDEXED:
+            displs = (int *)malloc(nblk * sizeof(int));
+            SMGC_MEMCHK(displs, out);
+            for (i = 0; i < nblk; ++i) {
+                displs[i] = perm[i] * 2 * blk;
+                offs[n] = perm[i] * stride;
+                lens[n++] = dt_block;
+            }
+            mpi_ret_code = MPI_Type_create_indexed_block(nblk, blk, displs,
+                                                         MPI_DOUBLE, type);
+            SMGC_MPICHK(mpi_ret_code, out);
+            break;
+        case SMGC_DT_STRUCT:
+            /* per block: blk doubles followed by an int */
+            mpi_ret_code = MPI_Type_create_struct(2, blens, sdispls, stypes,
+                                                  &tmp);
+            SMGC_MPICHK(mpi_ret_code, out);
+            mpi_ret_code = MPI_Type_create_resized(tmp, 0, (MPI_Aint)stride,
+                                                   &elem);
+            SMGC_MPICHK(mpi_ret_code, out);
+            mpi_ret_code = MPI_Type_contiguous(nblk, elem, type);
+            SMGC_MPICHK(mpi_ret_code, out);
+            for (i = 0; i < nblk; ++i) {
+                offs[n] = i * stride;
+                lens[n++] = dt_block;
+                offs[n] = i * stride + dt_block;
+                lens[n++] = sizeof(int);
+            }
+            break;
+        default:
+            SMGC_ERR_MSG("dt_build::unknown datatype %d\n", dt);
+            goto out;
     }
+    mpi_ret_code = MPI_Type_commit(type);
+    SMGC_MPICHK(mpi_ret_code, out);
+    *npieces = n;
 
-    srand((int)time(NULL));
-
-    SMGC_MPF("       message size: %d B\n", msg_size);
-
-    for (i = 0; i < num_itrs; ++i) {
-        /* let the master rank figure out the next "random" root */
-        if (SMGC_MASTER_RANK == my_rank) {
-            next_bc_root = rand() % num_ranks;
-            SMGC_FPF(stdout,
-                     "       %06d (%s): broadcasting to mpi_comm_world\n",
-                     next_bc_root, get_rhn(next_bc_root));
-        }
-        /* let mpi_comm_world know about the next bcast root */
-        mpi_ret_code = MPI_Bcast(&next_bc_root, 1, MPI_INT, SMGC_MASTER_RANK,
-                                 MPI_COMM_WORLD);
-        SMGC_MPICHK(mpi_ret_code, out);
-
-        /* root broadcast! */
-        mpi_ret_code = MPI_Bcast(char_buff, buff_size, MPI_CHAR, next_bc_root,
-                                 MPI_COMM_WORLD);
-        SMGC_MPICHK(mpi_ret_code, out);
-    }
-    /* success! */
     rc = SMGC_SUCCESS;
 out:
-    if (NULL != char_buff) {
-        free(char_buff);
-        char_buff = NULL;
+    if (MPI_DATATYPE_NULL != elem) MPI_Type_free(&elem);
+    if (MPI_DATATYPE_NULL != tmp) MPI_Type_free(&tmp);
+    if (NULL != displs) free(displs);
+    return rc;
+}
+
+/* ////////////////////////////////////////////////////////////////////////// */
+/**
+ * hand-written (un)packing: copies n pieces of layout to consecutive bytes
+ * of packed or, if unpack, the other way around.
+ */
+static void
+dt_copy_pieces(char *packed, char *layout, const size_t *offs,
+               const size_t *lens, int n, bool unpack)
+{
+    int i = 0;
+    size_t pos = 0;
+
+    for (i = 0; i < n; ++i) {
+        if (unpack) {
+            memcpy(layout + offs[i], packed + pos, lens[i]);
+        }
+        else {
+            memcpy(packed + pos, layout + offs[i], lens[i]);
+        }
+        pos += lens[i];
     }
-    return rc;
 }
 
 /* ////////////////////////////////////////////////////////////////////////// */
+/**
+ * average time (s) of a right shift around mpi_comm_world of one type from
+ * sbuf to rbuf using method: type itself, MPI_Pack/MPI_Unpack through
+ * pack_size B buffers or dt_copy_pieces and a payload B contiguous message.
+ */
 static int
-large_sendrecv_ring(void)
+dt_time(int method, MPI_Datatype type, const size_t *offs, const size_t *lens,
+        int n, char *sbuf, char *rbuf, char *spack, char *rpack, int payload,
+        int pack_size, double *t)
 {
-    int i = 0, num_iters = 4, send_tag  = 42, recv_tag = 42,
-        buff_size = msg_size, r_neighbor = 0, l_neighbor = 0;
-    char *send_char_buff = NULL, *recv_char_buff = NULL;
-    MPI_Status status;
-
-    r_neighbor = (my_rank + 1) % num_ranks;
-    l_neighbor = my_rank - 1;
-
-    if (l_neighbor < 0) {
-        l_neighbor = num_ranks - 1;
-    }
-
-    SMGC_MPF("       message size: %d B\n", buff_size);
-
-    for (i = 0; i < num_iters; ++i) {
-        send_char_buff = (char *)calloc(buff_size, sizeof(char));
-        SMGC_MEMCHK(send_char_buff, error);
-        recv_char_buff = (char *)calloc(buff_size, sizeof(char));
-        SMGC_MEMCHK(recv_char_buff, error);
-
-        SMGC_MPF("       =====================================>\n");
-
-        mpi_ret_code = MPI_Sendrecv(send_char_buff, buff_size,
-                                    MPI_CHAR, r_neighbor, send_tag,
-                                    recv_char_buff, buff_size, MPI_CHAR,
-                                    l_neighbor, recv_tag, MPI_COMM_WORLD,
-                                    &status);
-        SMGC_MPICHK(mpi_ret_code, error);
-
-        SMGC_MPF("       <=====================================\n");
+    int i = 0, pos = 0, tag = 42, r_neighbor = (my_rank + 1) % num_ranks,
+        l_neighbor = (my_rank + num_ranks - 1) % num_ranks;
+    double start = 0.0;
 
-        mpi_ret_code = MPI_Sendrecv(send_char_buff, buff_size,
-                                    MPI_CHAR, l_neighbor, send_tag,
-                                    recv_char_buff, buff_size, MPI_CHAR,
-                                    r_neighbor, recv_tag, MPI_COMM_WORLD,
-                                    &status);
-        SMGC_MPICHK(mpi_ret_code, error);
+    mpi_ret_code = MPI_Barrier(MPI_COMM_WORLD);
+    SMGC_MPICHK(mpi_ret_code, err);
 
-        free(send_char_buff);
-        send_char_buff = NULL;
-        free(recv_char_buff);
-        recv_char_buff = NULL;
+    start = MPI_Wtime();
+    for (i = 0; i < SMGC_DT_NUM_ITRS; ++i) {
+        switch (method) {
+            case SMGC_DT_DERIVED:
+                mpi_ret_code = MPI_Sendrecv(sbuf, 1, type, r_neighbor, tag,
+                                            rbuf, 1, type, l_neighbor, tag,
+                                            MPI_COMM_WORLD, MPI_STATUS_IGNORE);
+                SMGC_MPICHK(mpi_ret_code, err);
+                break;
+            case SMGC_DT_MPI_PACK:
+                pos = 0;
+                mpi_ret_code = MPI_Pack(sbuf, 1, type, spack, pack_size, &pos,
+                                        MPI_COMM_WORLD);
+                SMGC_MPICHK(mpi_ret_code, err);
+                mpi_ret_code = MPI_Sendrecv(spack, pos, MPI_PACKED,
+                                            r_neighbor, tag, rpack, pack_size,
+                                            MPI_PACKED, l_neighbor, tag,
+                                            MPI_COMM_WORLD, MPI_STATUS_IGNORE);
+                SMGC_MPICHK(mpi_ret_code, err);
+                pos = 0;
+                mpi_ret_code = MPI_Unpack(rpack, pack_size, &pos, rbuf, 1, type,
+                                          MPI_COMM_WORLD);
+                SMGC_MPICHK(mpi_ret_code, err);
+                break;
+            default:
+                dt_copy_pieces(spack, sbuf, offs, lens, n, false);
+                mpi_ret_code = MPI_Sendrecv(spack, payload, MPI_BYTE,
+                                            r_neighbor, tag, rpack, payload,
+                                            MPI_BYTE, l_neighbor, tag,
+                                            MPI_COMM_WORLD, MPI_STATUS_IGNORE);
+                SMGC_MPICHK(mpi_ret_code, err);
+                dt_copy_pieces(rpack, rbuf, offs, lens, n, true);
+                break;
+        }
     }
+    *t = (MPI_Wtime() - start) / SMGC_DT_NUM_ITRS;
 
     return SMGC_SUCCESS;
-error:
-    if (NULL != send_char_buff) {
-        free(send_char_buff);
-    }
-    if (NULL != recv_char_buff) {
-        free(recv_char_buff);
-    }
+err:
     return SMGC_ERROR;
 }
 
 /* ////////////////////////////////////////////////////////////////////////// */
+/**
+ * non-contiguous throughput. shifts vector, subarray, indexed and struct
+ * datatypes over a layout of dt_block B blocks (-B) spaced two blocks apart
+ * around a ring, each as a derived datatype, through MPI_Pack/MPI_Unpack
+ * and packed by hand into a contiguous message. reports the effective
+ * bandwidth (payload bytes only) of each next to a contiguous send of the
+ * same payload, so slow datatype engines stand out.
+ */
 static int
-alt_sendrecv_ring(void)
+dt_bw(void)
 {
-    int i = 0, num_iters = 4, send_tag  = 42, recv_tag = 42, buff_size = 0,
-        large_buff_size = msg_size, small_buff_size = 1, r_neighbor = 0,
-        l_neighbor = 0;
-    char *send_char_buff = NULL, *recv_char_buff = NULL;
-    char *large_msg_size_str = "=====================================";
-    char *small_msg_size_str = "-------------------------------------";
-    char *cur_size_str_ptr = large_msg_size_str;
-    MPI_Status status;
-
-    r_neighbor = (my_rank + 1) % num_ranks;
-    l_neighbor = my_rank - 1;
+    int i = 0, j = 0, tmp = 0, dt = 0, method = 0, c = 0, n = 0;
+    int size = int_msg_size(), nblk = size / (2 * dt_block), pack_size = 0;
+    int rc = SMGC_ERROR;
+    int r_wrank = (my_rank + 1) % num_ranks,
+        l_wrank = (my_rank + num_ranks - 1) % num_ranks;
+    int *perm = NULL;
+    size_t *offs = NULL, *lens = NULL, payload = 0;
+    char *sbuf = NULL, *rbuf = NULL, *spack = NULL, *rpack = NULL;
+    char label[64];
+    double t = 0.0;
+    uint64_t state = mix64(rng_seed);
+    MPI_Datatype type = MPI_DATATYPE_NULL;
+    smgc_wd_op_t *wd_op = NULL;
+
+    if (nblk < 1) {
+        SMGC_MPF("       message size < 2 blocks (%d B) - skipping\n",
+                 2 * dt_block);
+        return SMGC_SUCCESS;
+    }
 
-    if (l_neighbor < 0) {
-        l_neighbor = num_ranks - 1;
+    perm = (int *)malloc(nblk * sizeof(int));
+    SMGC_MEMCHK(perm, out);
+    offs = (size_t *)malloc(2 * nblk * sizeof(size_t));
+    SMGC_MEMCHK(offs, out);
+    lens = (size_t *)malloc(2 * nblk * sizeof(size_t));
+    SMGC_MEMCHK(lens, out);
+    /* the layouts span size B, the packed payloads less */
+    sbuf = (char *)arena_get(size);
+    SMGC_MEMCHK(sbuf, out);
+    rbuf = (char *)arena_get(size);
+    SMGC_MEMCHK(rbuf, out);
+    spack = (char *)arena_get(size);
+    SMGC_MEMCHK(spack, out);
+    rpack = (char *)arena_get(size);
+    SMGC_MEMCHK(rpack, out);
+
+    /* indexed blocks go in a seeded random order - the same on every rank */
+    for (i = 0; i < nblk; ++i) {
+        perm[i] = i;
+    }
+    for (i = nblk - 1; i > 0; --i) {
+        j = (int)(seeded_rand(&state) % (uint64_t)(i + 1));
+        tmp = perm[i];
+        perm[i] = perm[j];
+        perm[j] = tmp;
     }
 
-    SMGC_MPF("       message size key: === %d B, --- %d B\n", large_buff_size,
-             small_buff_size);
+    SMGC_MPF("       layout: %d B, block: %d B, stride: %d B, blocks: %d\n",
+             2 * nblk * dt_block, dt_block, 2 * dt_block, nblk);
+    SMGC_MPF("       %-26s %10s %10s %10s %12s  %s\n", "case (MB/s)", "min",
+             "ave", "max", "aggregate", "min rank");
 
-    for (i = 0; i < num_iters; ++i) {
-        /* what size buffs are we using this time around? */
-        if (0 != i % 2) {
-            buff_size = large_buff_size;
-            cur_size_str_ptr = large_msg_size_str;
+    wd_op = wd_op_begin("dt_bw", 0);
+
+    for (dt = 0; dt < SMGC_NUM_DTS; ++dt) {
+        if (SMGC_SUCCESS != dt_build(dt, nblk, perm, &type, offs, lens, &n)) {
+            goto out;
         }
-        else {
-            buff_size = small_buff_size;
-            cur_size_str_ptr = small_msg_size_str;
+        for (i = 0, payload = 0; i < n; ++i) {
+            payload += lens[i];
         }
+        mpi_ret_code = MPI_Pack_size(1, type, MPI_COMM_WORLD, &pack_size);
+        SMGC_MPICHK(mpi_ret_code, out);
 
-        send_char_buff = (char *)calloc(buff_size, sizeof(char));
-        SMGC_MEMCHK(send_char_buff, error);
-        recv_char_buff = (char *)calloc(buff_size, sizeof(char));
-        SMGC_MEMCHK(recv_char_buff, error);
-
-        SMGC_MPF("       %s>\n", cur_size_str_ptr);
-
-        mpi_ret_code = MPI_Sendrecv(send_char_buff, buff_size, MPI_CHAR,
-                                    r_neighbor, send_tag, recv_char_buff,
-                                    buff_size, MPI_CHAR, l_neighbor, recv_tag,
-                                    MPI_COMM_WORLD, &status);
-        SMGC_MPICHK(mpi_ret_code, error);
-
-        SMGC_MPF("       <%s\n", cur_size_str_ptr);
-
-        mpi_ret_code = MPI_Sendrecv(send_char_buff, buff_size, MPI_CHAR,
-                                    l_neighbor, send_tag, recv_char_buff,
-                                    buff_size, MPI_CHAR, r_neighbor, recv_tag,
-                                    MPI_COMM_WORLD, &status);
-        SMGC_MPICHK(mpi_ret_code, error);
+        for (method = 0; method < SMGC_NUM_DT_METHODS; ++method) {
+            /* there is nothing to pack */
+            if (SMGC_DT_CONTIG == dt && SMGC_DT_DERIVED != method) {
+                continue;
+            }
+            snprintf(label, sizeof(label), "%s %s", dt_names[dt],
+                     dt_method_names[method]);
+            if (SMGC_DT_MPI_PACK == method && pack_size > size) {
+                SMGC_MPF("       %-26s pack size %d B > %d B - skipping\n",
+                         label, pack_size, size);
+                continue;
+            }
+            /* a payload stream scattered over the layout - gaps are 0 */
+            memset(sbuf, 0, size);
+            memset(rbuf, 0, size);
+            payload_prep(spack, payload, my_rank, r_wrank, c);
+            dt_copy_pieces(spack, sbuf, offs, lens, n, true);
+
+            wd_op_step(wd_op, c, l_wrank, r_wrank);
+            if (SMGC_SUCCESS != dt_time(method, type, offs, lens, n, sbuf,
+                                        rbuf, spack, rpack, (int)payload,
+                                        pack_size, &t)) {
+                goto out;
+            }
 
-        free(send_char_buff);
-        send_char_buff = NULL;
-        free(recv_char_buff);
-        recv_char_buff = NULL;
+            /* gather what arrived and check it */
+            dt_copy_pieces(rpack, rbuf, offs, lens, n, false);
+            if (SMGC_SUCCESS != payload_verify(rpack, payload, l_wrank,
+                                               my_rank, c)) {
+                goto out;
+            }
+            if (SMGC_SUCCESS != rate_row_stats(label, (double)payload / t /
+                                                      SMGC_MB_SIZE)) {
+                goto out;
+            }
+            ++c;
+        }
+        mpi_ret_code = MPI_Type_free(&type);
+        SMGC_MPICHK(mpi_ret_code, out);
     }
+    wd_op_end(wd_op);
+    wd_op = NULL;
 
-    return SMGC_SUCCESS;
-error:
-    if (NULL != send_char_buff) {
-        free(send_char_buff);
-    }
-    if (NULL != recv_char_buff) {
-        free(recv_char_buff);
+    if (SMGC_SUCCESS != payload_verify_stats(MPI_COMM_WORLD)) {
+        goto out;
     }
-    return SMGC_ERROR;
+
+    rc = SMGC_SUCCESS;
+out:
+    wd_op_end(wd_op);
+    if (MPI_DATATYPE_NULL != type) MPI_Type_free(&type);
+    if (NULL != lens) free(lens);
+    if (NULL != offs) free(offs);
+    if (NULL != perm) free(perm);
+    return rc;
 }
 
+#ifdef HAVE_PTHREAD_H
 /* ////////////////////////////////////////////////////////////////////////// */
-static void
-reset_globs(void)
+/**
+ * thread_msg_rate worker: streams SMGC_TRATE_NUM_WINDOWS windows of small
+ * messages to and from its partner and checks what it received. it must not
+ * touch the error globals (see: SMGC_MPICHK), so failures only set arg->rc.
+ */
+static void *
+trate_main(void *arg)
 {
-    glob_loop_iter = 0;
-    glob_l_neighbor = 0;
-    glob_r_neighbor = 0;
+    int w = 0, k = 0;
+    smgc_trate_arg_t *ta = (smgc_trate_arg_t *)arg;
+    MPI_Request reqs[2 * SMGC_TRATE_WINDOW];
+
+    ta->rc = SMGC_ERROR;
+    memset(ta->sbuf, ta->val, sizeof(ta->sbuf));
+    memset(ta->rbuf, 0, sizeof(ta->rbuf));
+
+    for (w = 0; w < SMGC_TRATE_NUM_WINDOWS; ++w) {
+        for (k = 0; k < SMGC_TRATE_WINDOW; ++k) {
+            if (MPI_SUCCESS != MPI_Irecv(ta->rbuf + k * SMGC_TRATE_MSG_SIZE,
+                                         SMGC_TRATE_MSG_SIZE, MPI_CHAR,
+                                         ta->partner, ta->tag, ta->comm,
+                                         &reqs[k])) {
+                return NULL;
+            }
+        }
+        for (k = 0; k < SMGC_TRATE_WINDOW; ++k) {
+            if (MPI_SUCCESS != MPI_Isend(ta->sbuf, SMGC_TRATE_MSG_SIZE,
+                                         MPI_CHAR, ta->partner, ta->tag,
+                                         ta->comm,
+                                         &reqs[SMGC_TRATE_WINDOW + k])) {
+                return NULL;
+            }
+        }
+        if (MPI_SUCCESS != MPI_Waitall(2 * SMGC_TRATE_WINDOW, reqs,
+                                       MPI_STATUSES_IGNORE)) {
+            return NULL;
+        }
+    }
+    /* the partner's thread with the same index sends the same value */
+    for (k = 0; k < (int)sizeof(ta->rbuf); ++k) {
+        if (ta->val != ta->rbuf[k]) {
+            return NULL;
+        }
+    }
+    ta->rc = SMGC_SUCCESS;
+    return NULL;
 }
+#endif
 
 /* ////////////////////////////////////////////////////////////////////////// */
+/**
+ * runs nt thread_msg_rate workers against partner: each on its own
+ * communicator or, if shared, all on comms[0] told apart by tag. *t is the
+ * wall time from the first thread start to the last join.
+ */
 static int
-small_all_to_all_ptp(void)
+trate_run(int nt, bool shared, int partner, MPI_Comm *comms,
+          smgc_trate_arg_t *args, double *t)
 {
-    int i                = 0;
-    int j                = 0;
-    int rc               = SMGC_ERROR;
-    int l_neighbor       = 0;
-    int r_neighbor       = 0;
-    int buff_size        = 1;
-    char *send_char_buff = NULL;
-    char *recv_char_buff = NULL;
-    char *del            = "\b\b\b\b\b\b\b\b\b\b\b\b\b";
-    struct itimerval itimer;
-    MPI_Status status;
-
-    reset_globs();
-
-    send_char_buff = (char *)calloc(buff_size, sizeof(char));
-    SMGC_MEMCHK(send_char_buff, out);
-    recv_char_buff = (char *)calloc(buff_size, sizeof(char));
-    SMGC_MEMCHK(recv_char_buff, out);
-
-    SMGC_MPF("       message size: %d B\n", buff_size);
-    SMGC_MPF("       mpi_comm_world: all to all - ");
-
-    for (i = 1; i <= num_ranks; ++i, glob_loop_iter = i) {
-        SMGC_MPF("%s%06d/%06d%s", 1 == i ? "" : del, i, num_ranks,
-                 num_ranks == i ? "\n" : "");
+#ifdef HAVE_PTHREAD_H
+    int i = 0, started = 0, rc = SMGC_SUCCESS;
+    double start = 0.0;
+    pthread_t threads[SMGC_MAX_THREADS];
+
+    for (i = 0; i < nt; ++i) {
+        args[i].comm = shared ? comms[0] : comms[i];
+        args[i].partner = partner;
+        args[i].tag = shared ? i : 0;
+        args[i].val = (char)('a' + i % 26);
+        args[i].rc = SMGC_SUCCESS;
+    }
 
-        r_neighbor = (my_rank + i) % num_ranks;
-        l_neighbor = my_rank;
+    mpi_ret_code = MPI_Barrier(MPI_COMM_WORLD);
+    SMGC_MPICHK(mpi_ret_code, err);
 
-        for (j = 0; j < i; ++j) {
-            --l_neighbor;
-            if (l_neighbor < 0) {
-                l_neighbor = num_ranks - 1;
-            }
+    start = MPI_Wtime();
+    for (i = 0; i < nt && partner >= 0; ++i, ++started) {
+        if (0 != pthread_create(&threads[i], NULL, &trate_main, &args[i])) {
+            SMGC_ERR_MSG("pthread_create failed on rank %d (%s)\n", my_rank,
+                         host_name_buff);
+            rc = SMGC_ERROR;
+            break;
         }
-
-        glob_l_neighbor = l_neighbor;
-        glob_r_neighbor = r_neighbor;
-
-        TIMER_ENABLE(itimer);
-        mpi_ret_code = MPI_Sendrecv(send_char_buff, buff_size, MPI_CHAR,
-                                    r_neighbor, i, recv_char_buff, buff_size,
-                                    MPI_CHAR, l_neighbor, i, MPI_COMM_WORLD,
-                                    &status);
-        SMGC_MPICHK(mpi_ret_code, out);
-        TIMER_DISABLE(itimer);
     }
+    for (i = 0; i < started; ++i) {
+        pthread_join(threads[i], NULL);
+    }
+    *t = MPI_Wtime() - start;
 
-    /* all is well */
-    rc = SMGC_SUCCESS;
-
-out:
-    if (NULL != send_char_buff) free(send_char_buff);
-    if (NULL != recv_char_buff) free(recv_char_buff);
+    for (i = 0; i < started; ++i) {
+        if (SMGC_SUCCESS != args[i].rc) {
+            SMGC_ERR_MSG("thread_msg_rate: thread %d failed on rank %d (%s)\n",
+                         i, my_rank, host_name_buff);
+            rc = SMGC_ERROR;
+        }
+    }
     return rc;
+err:
+    return SMGC_ERROR;
+#else
+    (void)nt; (void)shared; (void)partner; (void)comms; (void)args; (void)t;
+    return SMGC_ERROR;
+#endif
 }
 
 /* ////////////////////////////////////////////////////////////////////////// */
+/**
+ * small message rate between rank pairs (rank i and rank i + numpe / 2) as a
+ * function of the number of threads per rank, each thread with its own
+ * communicator and all threads sharing one. a rate that does not grow with
+ * the thread count points at lock contention in the mpi library. needs
+ * -X and MPI_THREAD_MULTIPLE.
+ */
 static int
-large_all_to_all_ptp(void)
+thread_msg_rate(void)
 {
-    int i                = 0;
-    int j                = 0;
-    int rc               = SMGC_ERROR;
-    int l_neighbor       = 0;
-    int r_neighbor       = 0;
-    int buff_size        = msg_size;
-    char *send_char_buff = NULL;
-    char *recv_char_buff = NULL;
-    char *del            = "\b\b\b\b\b\b\b\b\b\b\b\b\b";
-    MPI_Status status;
-
-    send_char_buff = (char *)calloc(buff_size, sizeof(char));
-    SMGC_MEMCHK(send_char_buff, out);
-    recv_char_buff = (char *)calloc(buff_size, sizeof(char));
-    SMGC_MEMCHK(recv_char_buff, out);
-
-    SMGC_MPF("       message size: %d B\n", buff_size);
-    SMGC_MPF("       mpi_comm_world: all to all - ");
-
-    for (i = 1; i <= num_ranks; ++i) {
-        SMGC_MPF("%s%06d/%06d%s", 1 == i ? "" : del, i, num_ranks,
-                 num_ranks == i ? "\n" : "");
+    int i = 0, nt = 0, mode = 0, half = num_ranks / 2, partner = -1;
+    int rc = SMGC_ERROR;
+    char label[64];
+    double t = 0.0, rate = 0.0;
+    MPI_Comm comms[SMGC_MAX_THREADS];
+    smgc_trate_arg_t *args = NULL;
+    smgc_wd_op_t *wd_op = NULL;
+
+    if (0 == num_threads) {
+        SMGC_MPF("       no threads requested via -X option. skipping test.\n");
+        return SMGC_SUCCESS;
+    }
+#ifndef HAVE_PTHREAD_H
+    SMGC_MPF("       built without pthreads. skipping test.\n");
+    return SMGC_SUCCESS;
+#endif
+    if (MPI_THREAD_MULTIPLE != mpi_thread_level) {
+        SMGC_MPF("       mpi_thread_multiple not provided. skipping test.\n");
+        return SMGC_SUCCESS;
+    }
+    if (num_ranks < 2) {
+        SMGC_MPF("       at least 2 ranks are required - skipping\n");
+        return SMGC_SUCCESS;
+    }
 
-        r_neighbor = (my_rank + i) % num_ranks;
-        l_neighbor = my_rank;
+    if (my_rank < 2 * half) {
+        partner = (my_rank < half) ? (my_rank + half) : (my_rank - half);
+    }
 
-        for (j = 0; j < i; ++j) {
-            --l_neighbor;
-            if (l_neighbor < 0) {
-                l_neighbor = num_ranks - 1;
+    for (i = 0; i < num_threads; ++i) {
+        comms[i] = MPI_COMM_NULL;
+    }
+    for (i = 0; i < num_threads; ++i) {
+        mpi_ret_code = MPI_Comm_dup(MPI_COMM_WORLD, &comms[i]);
+        SMGC_MPICHK(mpi_ret_code, out);
+    }
+    args = (smgc_trate_arg_t *)calloc(num_threads, sizeof(smgc_trate_arg_t));
+    SMGC_MEMCHK(args, out);
+
+    SMGC_MPF("       message size: %d B, window: %d, messages per thread: %d\n",
+             SMGC_TRATE_MSG_SIZE, SMGC_TRATE_WINDOW,
+             SMGC_TRATE_WINDOW * SMGC_TRATE_NUM_WINDOWS);
+    SMGC_MPF("       %-26s %10s %10s %10s %12s  %s\n", "case (Mmsg/s)", "min",
+             "ave", "max", "aggregate", "min rank");
+
+    wd_op = wd_op_begin("thread_msg_rate", 0);
+
+    /* powers of two up to (and including) num_threads */
+    for (nt = 1; nt <= num_threads;
+         nt = (nt < num_threads && 2 * nt > num_threads) ? num_threads :
+                                                            2 * nt) {
+        for (mode = 0; mode < 2; ++mode) {
+            wd_op_step(wd_op, nt, partner, partner);
+            if (SMGC_SUCCESS != trate_run(nt, (1 == mode), partner, comms,
+                                          args, &t)) {
+                goto out;
+            }
+            rate = (partner < 0) ? -1.0 :
+                   ((double)nt * SMGC_TRATE_WINDOW * SMGC_TRATE_NUM_WINDOWS /
+                    t / 1e6);
+            snprintf(label, sizeof(label), "%d thread%s, %s", nt,
+                     (1 == nt) ? "" : "s",
+                     (1 == mode) ? "shared comm" : "comm each");
+            if (SMGC_SUCCESS != rate_row_stats(label, rate)) {
+                goto out;
             }
         }
-
-        mpi_ret_code = MPI_Sendrecv(send_char_buff, buff_size, MPI_CHAR,
-                                    r_neighbor, i, recv_char_buff, buff_size,
-                                    MPI_CHAR, l_neighbor, i, MPI_COMM_WORLD,
-                                    &status);
-        SMGC_MPICHK(mpi_ret_code, out);
     }
 
-    /* all is well */
     rc = SMGC_SUCCESS;
-
 out:
-    if (NULL != send_char_buff) free(send_char_buff);
-    if (NULL != recv_char_buff) free(recv_char_buff);
+    wd_op_end(wd_op);
+    for (i = 0; i < num_threads; ++i) {
+        if (MPI_COMM_NULL != comms[i]) MPI_Comm_free(&comms[i]);
+    }
+    if (NULL != args) free(args);
     return rc;
 }
 
@@ -1381,6 +7034,7 @@ main(int argc,
      char **argv)
 {
     int i = 0, ii = 0, c = 0, opt_indx = 0, num_iters = SMGC_DEF_NUM_ITRS;
+    size_t sz = 0;
     smgc_test_t *smgc_custom_jb_test_ptr = NULL;
 
     /* can't hurt */
@@ -1390,8 +7044,13 @@ main(int argc,
      */
     snprintf(host_name_buff, SMGC_HOST_NAME_MAX - 1, "%s", rhn_unknown);
 
-    /* init MPI */
-    mpi_ret_code = MPI_Init(&argc, &argv);
+    /* init MPI - only the main thread makes mpi calls (see: wd_main), unless
+     * threaded tests were requested
+     */
+    mpi_ret_code = MPI_Init_thread(&argc, &argv,
+                                   threads_requested(argc, argv) ?
+                                   MPI_THREAD_MULTIPLE : MPI_THREAD_FUNNELED,
+                                   &mpi_thread_level);
     SMGC_MPICHK(mpi_ret_code, error);
     mpi_ret_code = MPI_Comm_size(MPI_COMM_WORLD, &num_ranks);
     SMGC_MPICHK(mpi_ret_code, error);
@@ -1429,11 +7088,25 @@ main(int argc,
             {"quiet"      , no_argument,       0, 'q'},
             {"with-tests" , required_argument, 0, 't'},
             {"msg-timeout", required_argument, 0, 'T'},
+            {"sweep"      , required_argument, 0, 'S'},
+            {"window"     , required_argument, 0, 'W'},
+            {"top-links"  , required_argument, 0, 'k'},
+            {"hugepages"  , no_argument,       0, 'H'},
+            {"no-verify"  , no_argument,       0, 'N'},
+            {"node-aware" , no_argument,       0, 'L'},
+            {"seed"       , required_argument, 0, 'r'},
+            {"incast"     , no_argument,       0, 'I'},
+            {"threads"    , required_argument, 0, 'X'},
+            {"dt-block"   , required_argument, 0, 'B'},
+            {"roots"      , required_argument, 0, 'R'},
+            {"schedule"   , required_argument, 0, 'C'},
+            {"match-depth", required_argument, 0, 'D'},
             {0            , 0                , 0,  0 }
         };
 
-        c = getopt_long_only(argc, argv, "avVhs:w:n:m:M:qt:T:", long_options,
-                             &opt_indx);
+        c = getopt_long_only(argc, argv,
+                             "avVhs:w:n:m:M:qt:T:S:W:k:HNLIr:X:B:R:C:D:",
+                             long_options, &opt_indx);
 
         if (c == -1) {
             break;
@@ -1488,11 +7161,11 @@ main(int argc,
             case 'm': /* change the default message size */
                 i = atoi(optarg);
                 if (i > 0) {
-                    if (SMGC_SUCCESS != get_msg_size(optarg, "message", &i)) {
+                    if (SMGC_SUCCESS != get_msg_size(optarg, "message", &sz)) {
                         goto fin;
                     }
                     else {
-                        msg_size = i;
+                        msg_size = sz;
                     }
                 }
                 /* else we don't change the message size */
@@ -1501,11 +7174,11 @@ main(int argc,
             case 'M': /* change the default file size */
                 i = atoi(optarg);
                 if (i > 0) {
-                    if (SMGC_SUCCESS != get_msg_size(optarg, "file", &i)) {
+                    if (SMGC_SUCCESS != get_msg_size(optarg, "file", &sz)) {
                         goto fin;
                     }
                     else {
-                        file_size = i;
+                        file_size = sz;
                     }
                 }
                 /* else we don't change the file size */
@@ -1522,6 +7195,101 @@ main(int argc,
                 msg_timeout = strtol(optarg, (char **)NULL, 10);
                 break;
 
+            case 'W': /* number of in-flight exchanges */
+                i = atoi(optarg);
+                if (i > 0) {
+                    a2a_window = i;
+                }
+                break;
+
+            case 'C': /* all to all pairing schedule */
+                for (i = 0; i < SMGC_NUM_SCHEDS; ++i) {
+                    if (0 == strcmp(optarg, sched_names[i])) {
+                        a2a_sched = i;
+                        break;
+                    }
+                }
+                if (SMGC_NUM_SCHEDS == i) {
+                    SMGC_ERR_MSG("invalid schedule: %s\n", optarg);
+                    goto fin;
+                }
+                break;
+
+            case 'N': /* trust the network */
+                do_verify = false;
+                break;
+
+            case 'L': /* also run network tests on the node tiers */
+                node_aware = true;
+                break;
+
+            case 'H': /* back the buffer arena with huge pages */
+                use_hugepages = true;
+                break;
+
+            case 'k': /* number of slowest links to report */
+                i = atoi(optarg);
+                if (i > 0 && i <= SMGC_MAX_TOP_K_LINKS) {
+                    top_k_links = i;
+                }
+                break;
+
+            case 'I': /* all to root as an incast */
+                do_incast = true;
+                break;
+
+            case 'B': /* change the dt_bw block size */
+                i = atoi(optarg);
+                if (i > 0) {
+                    if (SMGC_SUCCESS != get_msg_size(optarg, "block", &sz)) {
+                        goto fin;
+                    }
+                    else if (sz > INT_MAX) {
+                        SMGC_ERR_MSG("requested block size is too large.\n");
+                        goto fin;
+                    }
+                    /* whole doubles */
+                    else if (sz >= sizeof(double)) {
+                        dt_block = (int)(sz - sz % sizeof(double));
+                    }
+                }
+                break;
+
+            case 'D': /* deepest match_stress queue */
+                i = atoi(optarg);
+                if (i >= SMGC_MATCH_MIN_DEPTH && i <= SMGC_MATCH_MAX_DEPTH) {
+                    match_depth = i;
+                }
+                break;
+
+            case 'R': /* number of bcast_root_map roots */
+                i = atoi(optarg);
+                if (i >= 0) {
+                    bcast_roots = i;
+                }
+                break;
+
+            case 'X': /* threads per rank in threaded tests */
+                i = atoi(optarg);
+                if (i <= 0 || i > SMGC_MAX_THREADS) {
+                    SMGC_ERR_MSG("invalid thread count: %s (1 to %d)\n",
+                                 optarg, SMGC_MAX_THREADS);
+                    goto fin;
+                }
+                num_threads = i;
+                break;
+
+            case 'r': /* seed for randomized tests */
+                rng_seed = strtoul(optarg, NULL, 10);
+                rng_seed_set = true;
+                break;
+
+            case 'S': /* sweep ring message sizes */
+                if (SMGC_SUCCESS != get_sweep_params(optarg)) {
+                    goto fin;
+                }
+                break;
+
             default:
                 usage();
                 goto fin;
@@ -1540,6 +7308,34 @@ main(int argc,
     }
     host_name_buff[SMGC_HOST_NAME_MAX - 1] = '\0';
 
+    /* size the buffer arena once - it is reused by every test and pass */
+    if (SMGC_SUCCESS != arena_init(arena_req_size())) {
+        goto error;
+    }
+
+    /* randomized tests draw from the master's seed */
+    if (!rng_seed_set && SMGC_MASTER_RANK == my_rank) {
+        rng_seed = (unsigned long)time(NULL);
+    }
+    mpi_ret_code = MPI_Bcast(&rng_seed, 1, MPI_UNSIGNED_LONG, SMGC_MASTER_RANK,
+                             MPI_COMM_WORLD);
+    SMGC_MPICHK(mpi_ret_code, error);
+
+    /* intra-node and node leader communicators */
+    if (SMGC_SUCCESS != tiers_init()) {
+        goto error;
+    }
+
+    /* on-demand remote host name lookups */
+    if (SMGC_SUCCESS != rhn_init()) {
+        goto error;
+    }
+
+    /* hang detection */
+    if (SMGC_SUCCESS != wd_start()) {
+        goto error;
+    }
+
     /* display info header */
     SMGC_MPF("\n   $$$ %s %s $$$\n\n", PACKAGE_NAME, PACKAGE_VERSION);
     SMGC_MPF("   start yyyymmdd-hhmmss  : %s\n", start_time_str);
@@ -1547,21 +7343,48 @@ main(int argc,
     SMGC_MPF("   numpe                  : %d\n", num_ranks);
     SMGC_MPF("   bin bloat              : %d B\n", SMGC_BIN_SIZE);
     SMGC_MPF("   default msg size       : %d B\n", SMGC_MSG_SIZE);
-    SMGC_MPF("   actual msg size        : %d B\n", msg_size);
+    SMGC_MPF("   actual msg size        : %lu B\n", (unsigned long)msg_size);
+    if (msg_size > SMGC_INT_MSG_MAX) {
+        SMGC_MPF("   int count msg size     : %d B (capped - see: -m)\n",
+                 SMGC_INT_MSG_MAX);
+    }
+    if (do_sweep) {
+        SMGC_MPF("   msg size sweep         : %d:%d:%d\n", sweep_min, sweep_max,
+                 sweep_factor);
+    }
+    SMGC_MPF("   exchange window        : %d\n", a2a_window);
+    SMGC_MPF("   all to all schedule    : %s\n", sched_names[a2a_sched]);
+    SMGC_MPF("   datatype block size    : %d B\n", dt_block);
+    SMGC_MPF("   num nodes              : %d\n", num_nodes);
+    SMGC_MPF("   max ranks/node         : %d\n", max_node_ranks);
+    SMGC_MPF("   node-aware             : %s\n", node_aware ?
+             (tiers[1].useful ? "yes" : "yes (single tier)") : "no");
+    SMGC_MPF("   verify payloads        : %s\n", do_verify ? "yes" : "no");
+    SMGC_MPF("   seed                   : %lu\n", rng_seed);
+    SMGC_MPF("   mpi thread support     : %s\n",
+             thread_level_str(mpi_thread_level));
+    SMGC_MPF("   max threads/rank       : %d\n", num_threads);
     SMGC_MPF("   message timeout        : %d %s\n",
              msg_timeout, msg_timeout < 0 ? "" : "s");
     SMGC_MPF("   default file size/rank : %d B\n", SMGC_MPI_IO_BUFF_SIZE);
     SMGC_MPF("   actual file size/rank  : %lu B\n", file_size);
+    SMGC_MPF("   buffer arena size/rank : %lu B%s\n",
+             (unsigned long)buff_arena.size,
+             buff_arena.huge ? " (huge pages)" : "");
     SMGC_MPF("   num iters              : %d\n", num_iters);
     SMGC_MPF("   num tests              : %d\n", num_tests);
     SMGC_MPF("\n");
 
     for (ii = 0; ii < num_iters; ++ii) {
         SMGC_MPF("   === starting pass %d of %d\n\n", (ii + 1), num_iters);
+        cur_pass = ii;
 
         /* run each test */
         for (i = 0; i < num_tests; ++i) {
             SMGC_MPF("   === starting : %s test\n", smgc_test_ptr[i].tname);
+            /* hand the test the whole buffer arena */
+            arena_reset();
+            verify_time = 0.0;
             /* run and check */
             SMGC_TSTCHK(smgc_test_ptr[i].tfp(), error);
             SMGC_MPF("   === done     : %s test\n", smgc_test_ptr[i].tname);
@@ -1584,6 +7407,10 @@ main(int argc,
     SMGC_MPF("   $$$ %s $$$\n\n", "carpe manana");
     SMGC_MPF("   <results> PASSED\n");
 
+    wd_stop();
+    rhn_fini();
+    tiers_fini();
+
     mpi_ret_code = MPI_Finalize();
     SMGC_MPICHK(mpi_ret_code, error);
 
@@ -1592,9 +7419,9 @@ main(int argc,
         start_time_str = NULL;
     }
 
-    if (NULL != rhname_lut_ptr) {
-        free(rhname_lut_ptr);
-    }
+    host_table_free(&host_table);
+
+    arena_fini();
 
     return EXIT_SUCCESS;
 
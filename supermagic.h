@@ -74,6 +74,18 @@
 #ifdef HAVE_SYS_TIME_H
 #include <sys/time.h>
 #endif
+#ifdef HAVE_SYS_MMAN_H
+#include <sys/mman.h>
+#endif
+#ifdef HAVE_PTHREAD_H
+#include <pthread.h>
+#endif
+#ifdef HAVE_SYS_STATVFS_H
+#include <sys/statvfs.h>
+#endif
+#ifdef HAVE_FLOAT_H
+#include <float.h>
+#endif
 
 #include "mpi.h"
 
@@ -92,28 +104,168 @@
 
 /* message size default */
 #define SMGC_MSG_SIZE (512 * 1024)
+/* largest message size used by tests that are limited to int counts */
+#define SMGC_INT_MSG_MAX (1 << 30)
+/* chunk size (B) of the datatypes that describe messages over INT_MAX B */
+#define SMGC_LC_CHUNK    (1 << 30)
+/* most bytes an exchange window keeps in flight (at least one message) */
+#define SMGC_WINDOW_MAX_BYTES (1 << 30)
 
-/* messaging timeout macros */
-#define TIMER_ENABLE(itimer)                                                   \
-do {                                                                           \
-    if (msg_timeout > 0) {                                                     \
-        (itimer).it_value.tv_sec = msg_timeout;                                \
-        (itimer).it_value.tv_usec = 0;                                         \
-        (itimer).it_interval = (itimer).it_value;                              \
-        signal(SIGALRM, &kill_mpi_messaging);                                  \
-        setitimer(ITIMER_REAL, &(itimer), NULL);                               \
-    }                                                                          \
-} while (0)
+/* message size sweep: untimed warmup exchanges per message size */
+#define SMGC_SWEEP_WARMUP_ITRS 4
+/* message size sweep: timed exchanges per message size */
+#define SMGC_SWEEP_NUM_ITRS    32
 
-#define TIMER_DISABLE(itimer)                                                  \
-do {                                                                           \
-    if (msg_timeout > 0) {                                                     \
-        (itimer).it_value.tv_sec = 0;                                          \
-        (itimer).it_value.tv_usec = 0;                                         \
-        (itimer).it_interval = (itimer).it_value;                              \
-        setitimer(ITIMER_REAL, &(itimer), NULL);                               \
-    }                                                                          \
-} while (0)
+/* default number of in-flight exchanges used by large_all_to_all_ptp */
+#define SMGC_A2A_WINDOW        8
+
+/* huge page size assumed when backing the buffer arena with huge pages */
+#define SMGC_HUGE_PAGE_SIZE    (1 << 21)
+
+/* payload pattern block length (in 64-bit words) - 4 KB */
+#define SMGC_PAYLOAD_BLK_WORDS 512
+/* payload destination used when a message has many receivers (e.g. bcast) */
+#define SMGC_PAYLOAD_ANY_RANK  -1
+
+/* default number of slowest links reported by small_all_to_all_ptp */
+#define SMGC_TOP_K_LINKS       8
+/* maximum number of slowest links that can be requested */
+#define SMGC_MAX_TOP_K_LINKS   1024
+
+/* watchdog: maximum number of operations tracked at once */
+#define SMGC_WD_MAX_OPS        64
+/* watchdog: how often the watchdog thread checks for progress (ms) */
+#define SMGC_WD_PERIOD_MS      250
+/* watchdog: time given to other ranks to report their hangs before exit (s) */
+#define SMGC_WD_GRACE_S        2
+
+/* atomics used to publish progress to the watchdog thread */
+#define SMGC_ATOMIC_STORE(ptr,val)  __atomic_store_n(ptr, val, __ATOMIC_RELEASE)
+#define SMGC_ATOMIC_LOAD(ptr)       __atomic_load_n(ptr, __ATOMIC_ACQUIRE)
+#define SMGC_RELAXED_STORE(ptr,val) __atomic_store_n(ptr, val, __ATOMIC_RELAXED)
+#define SMGC_RELAXED_LOAD(ptr)      __atomic_load_n(ptr, __ATOMIC_RELAXED)
+
+/* bisection_bw: number of random perfect matchings drawn per pass */
+#define SMGC_BISECT_MATCHINGS  4
+/* bisection_bw: messages streamed in each direction per matching */
+#define SMGC_BISECT_NUM_MSGS   16
+
+/* incast: messages sent to the root by every sender */
+#define SMGC_INCAST_NUM_MSGS      4
+/* incast: number of time buckets root ingress bandwidth is reported over */
+#define SMGC_INCAST_BUCKETS       8
+/* incast: senders done later than this many times the median are starved */
+#define SMGC_INCAST_STARVE_FACTOR 2.0
+/* incast: maximum number of starved senders listed */
+#define SMGC_INCAST_MAX_LISTED    8
+
+/* coll_suite: timed calls per collective and message size */
+#define SMGC_COLL_NUM_ITRS        8
+/* coll_suite: message size growth factor */
+#define SMGC_COLL_SIZE_FACTOR     8
+
+/* overlap: p2p messages are this many times msg_size... */
+#define SMGC_OVERLAP_P2P_MULT     4
+/* overlap: ...but at least this large (B), so they use a rendezvous protocol */
+#define SMGC_OVERLAP_P2P_MIN      (1 << 20)
+/* overlap: timed operations per measurement */
+#define SMGC_OVERLAP_NUM_ITRS     8
+
+/* persistent_ring: timed ring shifts per variant */
+#define SMGC_PRING_NUM_ITRS       16
+/* persistent_ring: partitions per partitioned message */
+#define SMGC_PRING_PARTITIONS     8
+
+/* rma tests: timed access epochs per case */
+#define SMGC_RMA_NUM_ITRS         8
+/* rma_gups: table words (uint64_t) exposed by each rank */
+#define SMGC_GUPS_TABLE_LEN       (1 << 16)
+/* rma_gups: random updates issued by each rank */
+#define SMGC_GUPS_NUM_UPDATES     1024
+/* rma_hotspot: atomic increments issued by each rank */
+#define SMGC_HOTSPOT_NUM_OPS      256
+
+/* thread_msg_rate: maximum number of threads per rank */
+#define SMGC_MAX_THREADS          64
+/* thread_msg_rate: message size (B) */
+#define SMGC_TRATE_MSG_SIZE       8
+/* thread_msg_rate: messages in flight per thread and direction */
+#define SMGC_TRATE_WINDOW         64
+/* thread_msg_rate: windows exchanged per thread */
+#define SMGC_TRATE_NUM_WINDOWS    64
+
+/* msg_rate: message size (B) */
+#define SMGC_MRATE_MSG_SIZE       8
+/* msg_rate: messages in flight per rank and direction */
+#define SMGC_MRATE_WINDOW         128
+/* msg_rate: windows exchanged per rank */
+#define SMGC_MRATE_NUM_WINDOWS    64
+/* msg_rate: nodes below this fraction of the median node rate are listed */
+#define SMGC_MRATE_SLOW_FRAC      0.8
+
+/* shm_bw: smallest and largest copy sizes (B) and the growth factor */
+#define SMGC_SHM_MIN_SIZE         (4 << 10)
+#define SMGC_SHM_MAX_SIZE         (4 << 20)
+#define SMGC_SHM_SIZE_FACTOR      4
+/* shm_bw: timed copies per size and path */
+#define SMGC_SHM_NUM_ITRS         16
+/* shm_bw: nodes where sendrecv gets below this fraction of load/store listed */
+#define SMGC_SHM_SLOW_FRAC        0.25
+/* shm_bw: nodes with less than this fraction of SMGC_SHM_PATH free listed */
+#define SMGC_SHM_MIN_FREE_FRAC    0.1
+/* shm_bw: tmpfs that shared memory segments usually live in */
+#define SMGC_SHM_PATH             "/dev/shm"
+
+/* match_stress: default (-D) and largest queue depth */
+#define SMGC_MATCH_DEPTH          4096
+#define SMGC_MATCH_MAX_DEPTH      16384
+/* match_stress: smallest queue depth and the growth factor */
+#define SMGC_MATCH_MIN_DEPTH      16
+#define SMGC_MATCH_DEPTH_FACTOR   4
+/* match_stress: tag of the handshakes - above every queued message's tag */
+#define SMGC_MATCH_SYNC_TAG       32767
+
+/* proto_thresholds: largest ping-pong size (B) and sizes per doubling */
+#define SMGC_PROTO_MAX_SIZE       (4 << 20)
+#define SMGC_PROTO_STEPS          4
+/* proto_thresholds: round trips per batch - the fastest batch is kept */
+#define SMGC_PROTO_NUM_ITRS       8
+#define SMGC_PROTO_NUM_BATCHES    4
+/* proto_thresholds: sweeps over all sizes - the fastest time is kept */
+#define SMGC_PROTO_NUM_SWEEPS     3
+/* proto_thresholds: latency changes beyond noise taken as protocol switches */
+#define SMGC_PROTO_JUMP_FRAC      0.2
+#define SMGC_PROTO_MIN_US         0.5
+/* proto_thresholds: most protocol switches reported per tier */
+#define SMGC_PROTO_MAX_SWITCHES   8
+
+/* comm_create: communicators created (and kept alive) per operation */
+#define SMGC_CC_NUM_ITRS          32
+
+/* dt_bw: default block size (B) - blocks are strided 2 blocks apart */
+#define SMGC_DT_BLOCK             64
+/* dt_bw: timed ring shifts per datatype and method */
+#define SMGC_DT_NUM_ITRS          8
+
+/* bcast_root_map: default number of sampled roots (-R 0: every root) */
+#define SMGC_BCAST_MAP_ROOTS      64
+/* bcast_root_map: timed broadcasts per root */
+#define SMGC_BCAST_MAP_ITRS       4
+/* bcast_root_map: number of slowest roots listed */
+#define SMGC_BCAST_MAP_WORST      8
+
+/* seeded streams (see: pass_seed) - matchings use 0 .. SMGC_BISECT_MATCHINGS */
+#define SMGC_SEED_RAND_ROOT       0x10000
+#define SMGC_SEED_ROOT_MAP        0x10001
+#define SMGC_SEED_SCHED_PERM      0x10002
+#define SMGC_SEED_SCHED_STEPS     0x10003
+#define SMGC_SEED_CC_COLOR        0x10004
+
+/* number of hash buckets in the on-demand remote host name cache */
+#define SMGC_RHN_CACHE_BUCKETS 256
+
+/* communicator tiers: all ranks, ranks sharing a node, one rank per node */
+#define SMGC_NUM_TIERS         3
 
 /* invalid color - all valid colors are expected to be positive values */
 #define SMGC_COLOR_INVALID -1
@@ -126,7 +278,110 @@ enum {
 
 enum {
     IO_STATS_MBS = 0,
-    IO_STATS_TIME_S
+    IO_STATS_TIME_S,
+    IO_STATS_TIME_US,
+    IO_STATS_PCT,
+    IO_STATS_MOPS
+};
+
+/* synchronization modes exercised by the rma tests */
+enum {
+    SMGC_RMA_FENCE = 0,
+    SMGC_RMA_PSCW,
+    SMGC_RMA_LOCK,
+    SMGC_NUM_RMA_SYNCS
+};
+
+/* one-sided operations timed by rma_bw */
+enum {
+    SMGC_RMA_PUT = 0,
+    SMGC_RMA_GET,
+    SMGC_RMA_ACC,
+    SMGC_NUM_RMA_OPS
+};
+
+/* operations exercised by the overlap test */
+enum {
+    SMGC_OVL_P2P = 0,
+    SMGC_OVL_IALLREDUCE,
+    SMGC_OVL_IBCAST,
+    SMGC_OVL_IALLTOALL,
+    SMGC_OVL_IBARRIER,
+    SMGC_NUM_OVL_OPS
+};
+
+/* ring variants exercised by persistent_ring */
+enum {
+    SMGC_PRING_SENDRECV = 0,
+    SMGC_PRING_PERSIST,
+    SMGC_PRING_PCOLL,
+    SMGC_PRING_PART,
+    SMGC_NUM_PRING
+};
+
+/* datatypes exercised by dt_bw */
+enum {
+    SMGC_DT_CONTIG = 0,
+    SMGC_DT_VECTOR,
+    SMGC_DT_SUBARRAY,
+    SMGC_DT_INDEXED,
+    SMGC_DT_STRUCT,
+    SMGC_NUM_DTS
+};
+
+/* ways dt_bw moves a datatype */
+enum {
+    SMGC_DT_DERIVED = 0,
+    SMGC_DT_MPI_PACK,
+    SMGC_DT_MANUAL,
+    SMGC_NUM_DT_METHODS
+};
+
+/* all to all pairing schedules (see: sched_peer) */
+enum {
+    SMGC_SCHED_SHIFT = 0,
+    SMGC_SCHED_XOR,
+    SMGC_SCHED_RANDOM,
+    SMGC_SCHED_TRANSPOSE,
+    SMGC_SCHED_TORNADO,
+    SMGC_NUM_SCHEDS
+};
+
+/* queues built by match_stress */
+enum {
+    SMGC_MATCH_UNEXP = 0,
+    SMGC_MATCH_UNEXP_ANY_SRC,
+    SMGC_MATCH_UNEXP_ANY_TAG,
+    SMGC_MATCH_POSTED,
+    SMGC_MATCH_POSTED_ANY_SRC,
+    SMGC_NUM_MATCH_MODES
+};
+
+/* communicator constructors timed by comm_create */
+enum {
+    SMGC_CC_DUP = 0,
+    SMGC_CC_SPLIT_ONE,
+    SMGC_CC_SPLIT_TWO,
+    SMGC_CC_SPLIT_BLOCKS,
+    SMGC_CC_SPLIT_RAND,
+    SMGC_CC_SPLIT_SELF,
+    SMGC_CC_SPLIT_TYPE,
+    SMGC_CC_IDUP,
+    SMGC_CC_CREATE_GROUP,
+    SMGC_NUM_CCS
+};
+
+/* collectives exercised by coll_suite */
+enum {
+    SMGC_COLL_ALLREDUCE = 0,
+    SMGC_COLL_REDUCE,
+    SMGC_COLL_ALLGATHER,
+    SMGC_COLL_ALLTOALL,
+    SMGC_COLL_REDUCE_SCATTER,
+    SMGC_COLL_GATHER,
+    SMGC_COLL_SCATTER,
+    SMGC_COLL_BARRIER,
+    SMGC_NUM_COLLS
 };
 
 #define SMGC_USAGE                                                             \
@@ -134,13 +389,32 @@ enum {
 "    mpirun -np N ./"PACKAGE_NAME" [OPTION] ... \n\n"                          \
 "options:\n"                                                                   \
 "    [-a|--all]                   run all tests in suite\n"                    \
+"    [-B|--dt-block x[B,k,M,G]]   change datatype block size (dt_bw)\n"        \
+"    [-C|--schedule X]            all to all pairing schedule: shift, xor,\n"  \
+"                                 random, transpose or tornado\n"              \
+"    [-D|--match-depth X]         deepest queue built by match_stress\n"       \
 "    [-h|--help]                  display this message\n"                      \
-"    [-m|--msg-size x[B,k,M,G]]   change message size\n"                       \
+"    [-H|--hugepages]             back message buffers with huge pages\n"      \
+"    [-I|--incast]                pre-post any source receives at the root\n"  \
+"    [-k|--top-links X]           report the X slowest links (all to all)\n"   \
+"    [-L|--node-aware]            also run network tests intra/inter-node\n"   \
+"    [-m|--msg-size x[B,k,M,G]]   change message size - capped at 1 GB in\n"   \
+"                                 large_all_to_root_ptp, rand_root_bcast,\n"   \
+"                                 bcast_root_map, persistent_ring,\n"          \
+"                                 coll_suite, overlap, bisection_bw, rma_bw\n" \
+"                                 and dt_bw\n"                                 \
 "    [-M|--file-size B[B,k,M,G]]  change file size (per rank)\n"               \
 "    [-n|--n-iters X]             run X iterations of a test suite\n"          \
+"    [-N|--no-verify]             do not verify received message payloads\n"   \
 "    [-q|--quiet]                 run in quiet mode\n"                         \
+"    [-r|--seed X]                seed randomized tests with X\n"              \
+"    [-R|--roots X]               time X roots in bcast_root_map (0: all)\n"   \
 "    [-s|--stat /a/path]          add /a/path to stat list\n"                  \
+"    [-S|--sweep min:max:factor]  sweep ring message sizes (e.g. 1:4M:2)\n"    \
 "    [-t|--with-tests t1[,t2,tn]] run tests in requested order\n"              \
+"    [-T|--msg-timeout X]         report hangs after X s without progress\n"   \
+"    [-W|--window X]              keep X exchanges in flight (all to all)\n"   \
+"    [-X|--threads X]             run threaded tests with up to X threads\n"   \
 "    [-w|--write /a/path]         add /a/path to IO tests\n"                   \
 "    [-V|--verbose]               display verbose output\n"                    \
 
@@ -157,6 +431,9 @@ enum {
 
 #define SMGC_MBS_UNIT_STR     "MB/s"
 #define SMGC_TIME_S_UNIT_STR  "s"
+#define SMGC_TIME_US_UNIT_STR "us"
+#define SMGC_PCT_UNIT_STR     "%"
+#define SMGC_MOPS_UNIT_STR    "Mops/s"
 #define SMGC_DATE_FORMAT      "%Y%m%d-%H%M%S"
 #define SMGC_MPI_FILE_NAME    "FS_TEST_FILE-YOU_CAN_DELETE_ME"
 
@@ -175,6 +452,9 @@ enum {
 /* i/o file size: 4 KB per rank process is the default */
 #define SMGC_MPI_IO_BUFF_SIZE (1 << 12)
 
+/* rounds x up to the nearest multiple of a */
+#define SMGC_ROUND_UP(x,a)    ((((x) + (a) - 1) / (a)) * (a))
+
 /* stringification stuff */
 #define SMGC_STRINGIFY(x)     #x
 #define SMGC_TOSTRING(x)      SMGC_STRINGIFY(x)
@@ -239,9 +519,6 @@ do {                                                                           \
 /* ////////////////////////////////////////////////////////////////////////// */
 /* globals                                                                    */
 /* ////////////////////////////////////////////////////////////////////////// */
-static int glob_loop_iter = 0;
-static int glob_l_neighbor = 0;
-static int glob_r_neighbor = 0;
 /* no timeout by default */
 static int msg_timeout = -1;
 
@@ -263,6 +540,141 @@ typedef struct double_int_t {
     int rank;
 } double_int_t;
 
+/* preallocated memory that tests borrow their message buffers from */
+typedef struct smgc_arena_t {
+    /* start of the arena */
+    char *base;
+    /* arena size (B) */
+    size_t size;
+    /* bytes handed out since the last reset */
+    size_t used;
+    /* alignment of every slice */
+    size_t page_size;
+    /* was the arena mmap'd (as opposed to allocated on the heap)? */
+    bool mapped;
+    /* is the arena backed by huge pages? */
+    bool huge;
+} smgc_arena_t;
+
+/* an operation watched by the watchdog thread */
+typedef struct smgc_wd_op_t {
+    /* progress counter bumped by the owner on every step - 0 when idle */
+    unsigned long seq;
+    /* name of the test (or collective) that owns the operation */
+    const char *tname;
+    /* current step and peers (-1: any/all) - published before seq */
+    int step;
+    int src;
+    int dst;
+    /* seconds without progress before the operation is considered hung */
+    int timeout;
+    /* watchdog private: last seq observed and when it was first observed */
+    unsigned long seen_seq;
+    double seen_time;
+} smgc_wd_op_t;
+
+/* a communicator that network tests can be run over */
+typedef struct smgc_tier_t {
+    /* tier name - used in place of mpi_comm_world in test output */
+    const char *name;
+    /* what the tier exercises */
+    const char *desc;
+    /* MPI_COMM_NULL if this rank is not a member */
+    MPI_Comm comm;
+    /* my rank in comm and the size of comm */
+    int rank;
+    int size;
+    /* communicator results are reduced over (its rank 0 is the master) */
+    MPI_Comm stats_comm;
+    /* maps tier ranks to mpi_comm_world ranks */
+    int *world_ranks;
+    /* is the tier worth running (more than one rank in some instance)? */
+    bool useful;
+} smgc_tier_t;
+
+/* a test body that runs on a single tier */
+typedef int (*tier_func_ptr)(smgc_tier_t *);
+
+/* a timed point-to-point link: src sent to dst in lat seconds */
+typedef struct link_lat_t {
+    double lat;
+    int src;
+    int dst;
+} link_lat_t;
+
+/* a remote host name fetched on demand */
+typedef struct smgc_rhn_ent_t {
+    int rank;
+    struct smgc_rhn_ent_t *next;
+    char name[SMGC_HOST_NAME_MAX];
+} smgc_rhn_ent_t;
+
+/* state of a thread_msg_rate worker thread */
+typedef struct smgc_trate_arg_t {
+    /* communicator, peer and tag the thread exchanges on */
+    MPI_Comm comm;
+    int partner;
+    int tag;
+    /* byte value every message of this thread carries */
+    char val;
+    /* SMGC_SUCCESS, unless an mpi call or a payload check failed */
+    int rc;
+    char sbuf[SMGC_TRATE_MSG_SIZE];
+    char rbuf[SMGC_TRATE_WINDOW * SMGC_TRATE_MSG_SIZE];
+} smgc_trate_arg_t;
+
+/* an all to all pairing schedule over n ranks (see: sched_init) */
+typedef struct smgc_sched_t {
+    /* SMGC_SCHED_* actually in use - may differ from the requested one */
+    int kind;
+    int n;
+    /* transpose: side of the square rank grid */
+    int side;
+    /* random: rank relabeling, its inverse and the order of the steps */
+    int *perm;
+    int *inv;
+    int *steps;
+} smgc_sched_t;
+
+/* the two ranks of a proto_thresholds ping-pong (see: proto_pingpong) */
+typedef struct smgc_pp_t {
+    /* the pair - its rank 0 times and prints */
+    MPI_Comm comm;
+    int rank;
+    /* mpi_comm_world rank of the other rank */
+    int peer_w;
+    /* measurements so far - tags payloads and watchdog steps */
+    int iter;
+    char *sbuf;
+    char *rbuf;
+    smgc_wd_op_t *wd_op;
+} smgc_pp_t;
+
+/* a change in the latency vs. size curve found by proto_thresholds */
+typedef struct smgc_proto_sw_t {
+    /* 1: slower than bandwidth explains -1: faster */
+    int dir;
+    /* adjacent sizes (B) on either side and their latencies (us) */
+    int lo;
+    int hi;
+    double lo_lat;
+    double hi_lat;
+    /* latency growth (us/B) expected without a switch */
+    double slope;
+} smgc_proto_sw_t;
+
+/* host names of every rank: one name per node plus a rank to node index */
+typedef struct smgc_host_table_t {
+    /* number of nodes (names) in the table */
+    int num_nodes;
+    /* nul-terminated node host names, back to back */
+    char *names;
+    /* offset of each node's name in names */
+    int *name_offs;
+    /* node index of every mpi_comm_world rank */
+    int *rank_node;
+} smgc_host_table_t;
+
 #if 0
 static int
 get_net_num(const char *target_hostname,
@@ -276,14 +688,125 @@ static int
 create_test_list(const char *, smgc_test_t **);
 
 static int
-get_msg_size(const char *, const char *, int *);
+get_msg_size(const char *, const char *, size_t *);
+
+static int
+get_sweep_params(const char *);
+
+static int
+int_msg_size(void);
+
+static int
+window_msgs(size_t);
+
+static int
+lc_type(size_t, MPI_Datatype *, int *);
+
+static void
+lc_type_free(MPI_Datatype *);
+
+static int
+lc_sendrecv(const void *, size_t, int, void *, int, int, MPI_Comm);
+
+static int
+lc_bcast(void *, size_t, int, MPI_Comm);
+
+static int
+lc_isend(const void *, size_t, int, int, MPI_Comm, MPI_Request *);
+
+static int
+lc_irecv(void *, size_t, int, int, MPI_Comm, MPI_Request *);
+
+static int
+sendrecv_ring_sweep(smgc_tier_t *, bool);
+
+static size_t
+arena_req_size(void);
+
+static size_t
+test_arena_size(func_ptr);
+
+static int
+arena_init(size_t);
+
+static void *
+arena_get(size_t);
+
+static void
+arena_reset(void);
+
+static void
+arena_fini(void);
+
+static uint64_t
+payload_seed(int, int, int);
+
+static void
+payload_fill(void *, size_t, uint64_t);
+
+static int
+payload_check(const void *, size_t, uint64_t, size_t *);
+
+static void
+payload_prep(void *, size_t, int, int, int);
+
+static int
+payload_verify(const void *, size_t, int, int, int);
+
+static int
+payload_verify_stats(MPI_Comm);
+
+static void
+top_links_insert(link_lat_t *, int, double, int, int);
+
+static void
+top_links_merge(void *, void *, int *, MPI_Datatype *);
+
+static int
+top_links_report(MPI_Comm, link_lat_t *, int);
 
 static int
 small_allreduce_max(void);
 
+static int
+coll_suite(void);
+
+static int
+overlap(void);
+
+static size_t
+overlap_p2p_size(void);
+
+static double
+compute_for(double);
+
+static int
+overlap_post(int, char *, char *, int, MPI_Request *);
+
+static int
+overlap_time(int, char *, char *, int, double, double *);
+
+static bool
+coll_scales(int);
+
+static void
+coll_init(int, double *, int);
+
+static int
+coll_run(int, double *, double *, int);
+
+static int
+coll_check(int, const double *, int);
+
+static int
+coll_time_stats(int, int, double);
+
 static int
 hostname_exchange(void);
 
+static void
+host_table_free(smgc_host_table_t *);
+
 #if 0
 static int
 host_info_exchange(void);
@@ -292,27 +815,201 @@ host_info_exchange(void);
 static int
 large_all_to_root_ptp(void);
 
+static int
+all_to_root_incast(void);
+
+static int
+qsort_cmp_dbl(const void *, const void *);
+
 static int
 alt_sendrecv_ring(void);
 
+static int
+alt_sendrecv_ring_tier(smgc_tier_t *);
+
 static int
 large_sendrecv_ring(void);
 
+static int
+large_sendrecv_ring_tier(smgc_tier_t *);
+
+static int
+persistent_ring(void);
+
+static int
+persistent_ring_tier(smgc_tier_t *);
+
+static int
+pring_time(int, smgc_tier_t *, char *, char *, int, double *);
+
+static int
+pring_time_stats(smgc_tier_t *, int, double, double *);
+
 static int
 small_all_to_all_ptp(void);
 
+static int
+small_all_to_all_ptp_tier(smgc_tier_t *);
+
 static int
 large_all_to_all_ptp(void);
 
+static int
+large_all_to_all_ptp_tier(smgc_tier_t *);
+
 static int
 stat_paths(void);
 
 static int
 root_bcast(void);
 
+static int
+bisection_bw(void);
+
+static int
+matching_partner(const int *, int, int);
+
+static int
+rma_bw(void);
+
+static int
+rma_win_open(bool, int, char **, MPI_Aint *, MPI_Win *);
+
+static int
+rma_xfer_time(MPI_Win, int, int, int, int, MPI_Aint, char *, int, double *);
+
+static unsigned
+rma_acc_val(int, int, int);
+
+static int
+rma_acc_verify(const unsigned *, int, int, int);
+
+static int
+rate_row_stats(const char *, double);
+
+static int
+rma_gups(void);
+
+static int
+rma_hotspot(void);
+
+static int
+msg_rate(void);
+
+static int
+dt_bw(void);
+
+static int
+dt_build(int, int, const int *, MPI_Datatype *, size_t *, size_t *, int *);
+
+static void
+dt_copy_pieces(char *, char *, const size_t *, const size_t *, int, bool);
+
+static int
+dt_time(int, MPI_Datatype, const size_t *, const size_t *, int, char *,
+        char *, char *, char *, int, int, double *);
+
+static int
+msg_rate_partner(int *);
+
+static int
+msg_rate_slow_nodes(double);
+
+static int
+shm_bw(void);
+
+static int
+shm_bw_nodes(double);
+
+static int
+comm_create(void);
+
+static int
+cc_create(int, MPI_Group, MPI_Comm *);
+
+static int
+cc_row(const char *, int, const double *, double);
+
+static long
+vm_rss_kb(void);
+
+static int
+match_stress(void);
+
+static int
+match_round(int, int, int, bool, int *, MPI_Request *, double *);
+
+static int
+proto_thresholds(void);
+
+static int
+proto_tier(const smgc_tier_t *, MPI_Comm);
+
+static int
+proto_pingpong(smgc_pp_t *, int, double *);
+
+static int
+proto_switch(int, double, int, double, double);
+
+static int
+proto_retime(smgc_pp_t *, smgc_proto_sw_t *, bool *);
+
+static int
+proto_bisect(smgc_pp_t *, smgc_proto_sw_t *);
+
+static bool
+threads_requested(int, char **);
+
+static int
+thread_msg_rate(void);
+
+static int
+trate_run(int, bool, int, MPI_Comm *, smgc_trate_arg_t *, double *);
+
+#ifdef HAVE_PTHREAD_H
+static void *
+trate_main(void *);
+#endif
+
+static uint64_t
+seeded_rand(uint64_t *);
+
+static void
+draw_matching(int *, int, int);
+
+static uint64_t
+pass_seed(uint32_t);
+
+static int
+sched_init(smgc_sched_t *, int, int);
+
+static void
+sched_fini(smgc_sched_t *);
+
+static void
+sched_print(const smgc_sched_t *);
+
+static int
+sched_peer(const smgc_sched_t *, int, int, bool);
+
+static int
+bcast_root_map(void);
+
+static int
+bcast_root_map_tier(smgc_tier_t *);
+
+static int
+qsort_cmp_dint_desc(const void *, const void *);
+
+static int
+root_bcast_tier(smgc_tier_t *);
+
 static int
 rand_root_bcast(void);
 
+static int
+rand_root_bcast_tier(smgc_tier_t *);
+
 static void
 usage(void);
 
@@ -322,6 +1019,15 @@ get_time_str(time_t *);
 static char *
 get_rhn(int rank);
 
+static char *
+get_rhn_cached(int rank);
+
+static int
+rhn_init(void);
+
+static void
+rhn_fini(void);
+
 static void
 set_jb_params(void);
 
@@ -331,6 +1037,9 @@ get_num_tests(smgc_test_t *);
 static void
 upd_test_suite(smgc_test_t *);
 
+static char *
+thread_level_str(int);
+
 static int
 mpi_io(void);
 
@@ -340,8 +1049,35 @@ n_to_n_io(void);
 static int
 io_stats(double_int_t, char *, int);
 
+static int
+comm_stats(MPI_Comm, double_int_t, char *, int);
+
+static int
+tiers_init(void);
+
+static int
+tier_wrank(const smgc_tier_t *, int);
+
+static void
+tiers_fini(void);
+
+static int
+run_on_tiers(tier_func_ptr);
+
+static int
+wd_start(void);
+
+static void
+wd_stop(void);
+
+static smgc_wd_op_t *
+wd_op_begin(const char *, int);
+
 static void
-kill_mpi_messaging(int sig);
+wd_op_step(smgc_wd_op_t *, int, int, int);
+
+static void
+wd_op_end(smgc_wd_op_t *);
 
 #if SMGC_HAVE_CELL_SUPPORT == 1
 static int
@@ -369,8 +1105,12 @@ static char fs_test_list[SMGC_MAX_FS_TEST_PATHS][SMGC_PATH_MAX];
 static char bin_bloat[SMGC_BIN_SIZE] = {'x'};
 /* host name buffer                                                           */
 static char host_name_buff[SMGC_HOST_NAME_MAX];
-/* remote hostname lookup table pointer                                       */
-static char *rhname_lut_ptr = NULL;
+/* remote host name lookup table - populated by hostname_exchange             */
+static smgc_host_table_t host_table = {0, NULL, NULL, NULL};
+/* exposes host_name_buff to on-demand remote host name lookups               */
+static MPI_Win rhn_win = MPI_WIN_NULL;
+/* remote host names fetched on demand so far                                 */
+static smgc_rhn_ent_t *rhn_cache[SMGC_RHN_CACHE_BUCKETS];
 /* start time string                                                          */
 static char *start_time_str = NULL;
 /* start time                                                                 */
@@ -396,7 +1136,112 @@ static int num_stat_paths = 0;
 /* number of paths to run IO tests on                                         */
 static int num_fs_test_paths = 0;
 /* message size                                                               */
-static int msg_size = SMGC_MSG_SIZE;
+static size_t msg_size = SMGC_MSG_SIZE;
+/* flag that dictates whether or not the ring tests sweep message sizes       */
+static bool do_sweep = false;
+/* smallest message size in a sweep (B)                                       */
+static int sweep_min = 1;
+/* largest message size in a sweep (B)                                        */
+static int sweep_max = SMGC_MSG_SIZE;
+/* message size growth factor between sweep steps                             */
+static int sweep_factor = 2;
+/* number of non-blocking exchanges kept in flight by windowed tests          */
+static int a2a_window = SMGC_A2A_WINDOW;
+/* pairing schedule of the all to all tests                                   */
+static int a2a_sched = SMGC_SCHED_SHIFT;
+/* number of slowest links reported by small_all_to_all_ptp                   */
+static int top_k_links = SMGC_TOP_K_LINKS;
+/* flag that dictates whether or not the buffer arena uses huge pages         */
+static bool use_hugepages = false;
+/* message and i/o buffer arena - shared by all tests and passes              */
+static smgc_arena_t buff_arena = {NULL, 0, 0, 0, false, false};
+/* flag that dictates whether or not received payloads are verified           */
+static bool do_verify = true;
+/* time spent verifying payloads during the current test                      */
+static double verify_time = 0.0;
+/* current test suite pass - folded into payload seeds                        */
+static int cur_pass = 0;
+/* operations watched by the watchdog thread                                  */
+static smgc_wd_op_t wd_ops[SMGC_WD_MAX_OPS];
+#ifdef HAVE_PTHREAD_H
+/* watchdog thread                                                            */
+static pthread_t wd_thread;
+/* protects watchdog slot ownership and wd_stop_req                           */
+static pthread_mutex_t wd_lock = PTHREAD_MUTEX_INITIALIZER;
+/* wakes the watchdog thread up early when it is asked to stop                */
+static pthread_cond_t wd_cond = PTHREAD_COND_INITIALIZER;
+/* flag that tells the watchdog thread to exit                                */
+static bool wd_stop_req = false;
+#endif
+/* is the watchdog thread running?                                            */
+static bool wd_running = false;
+/* flag that dictates whether or not large_all_to_root_ptp runs as an incast  */
+static bool do_incast = false;
+/* flag that dictates whether or not network tests also run on node tiers     */
+static bool node_aware = false;
+/* mpi_comm_world, intra-node and node leader (inter-node) tiers              */
+static smgc_tier_t tiers[SMGC_NUM_TIERS];
+/* number of nodes (shared memory domains) in the job                         */
+static int num_nodes = 0;
+/* largest number of ranks sharing a node                                     */
+static int max_node_ranks = 0;
+/* thread support level provided by the mpi library                           */
+static int mpi_thread_level = MPI_THREAD_SINGLE;
+/* maximum number of threads per rank in threaded tests (0: not requested)    */
+static int num_threads = 0;
+/* names of the collectives exercised by coll_suite                           */
+static const char *coll_names[SMGC_NUM_COLLS] = {
+    "allreduce", "reduce", "allgather", "alltoall", "reduce_scatter",
+    "gather", "scatter", "barrier"
+};
+/* names of the operations exercised by the overlap test                      */
+static const char *ovl_names[SMGC_NUM_OVL_OPS] = {
+    "isend/irecv", "iallreduce", "ibcast", "ialltoall", "ibarrier"
+};
+/* names of the ring variants exercised by persistent_ring                    */
+static const char *pring_names[SMGC_NUM_PRING] = {
+    "sendrecv", "send/recv_init", "neighbor_init", "psend/precv"
+};
+/* names of the synchronization modes exercised by the rma tests              */
+static const char *rma_sync_names[SMGC_NUM_RMA_SYNCS] = {
+    "fence", "pscw", "lock"
+};
+/* names of the one-sided operations timed by rma_bw                          */
+static const char *rma_op_names[SMGC_NUM_RMA_OPS] = {
+    "put", "get", "acc"
+};
+/* names of the all to all pairing schedules                                  */
+static const char *sched_names[SMGC_NUM_SCHEDS] = {
+    "shift", "xor", "random", "transpose", "tornado"
+};
+/* names of the queues built by match_stress                                  */
+static const char *match_names[SMGC_NUM_MATCH_MODES] = {
+    "unexp", "unexp any_src", "unexp any_tag", "posted", "posted any_src"
+};
+/* deepest queue built by match_stress                                        */
+static int match_depth = SMGC_MATCH_DEPTH;
+/* names of the communicator constructors timed by comm_create               */
+static const char *cc_names[SMGC_NUM_CCS] = {
+    "dup", "split (1 color)", "split (2 colors)", "split (sqrt(n) blocks)",
+    "split (random)", "split (n colors)", "split_type (shared)", "idup",
+    "create_group (even ranks)"
+};
+/* names of the datatypes exercised by dt_bw                                  */
+static const char *dt_names[SMGC_NUM_DTS] = {
+    "contiguous", "vector", "subarray", "indexed", "struct"
+};
+/* names of the ways dt_bw moves a datatype                                   */
+static const char *dt_method_names[SMGC_NUM_DT_METHODS] = {
+    "derived", "mpi_pack", "manual"
+};
+/* number of roots timed by bcast_root_map (0: every root)                    */
+static int bcast_roots = SMGC_BCAST_MAP_ROOTS;
+/* dt_bw block size (B) - a multiple of sizeof(double)                        */
+static int dt_block = SMGC_DT_BLOCK;
+/* seed shared by all ranks for randomized tests - broadcast from the master  */
+static unsigned long rng_seed = 0;
+/* was the seed given on the command line?                                    */
+static bool rng_seed_set = false;
 /* flag that dictates whether or not verbose output will be displayed         */
 static bool be_verbose = false;
 /* flag that dictates whether or not we are in quiet mode                     */
@@ -429,9 +1274,24 @@ static smgc_test_t smgc_all_tests[] =
     {"alt_sendrecv_ring"    , &alt_sendrecv_ring    },
     {"root_bcast"           , &root_bcast           },
     {"large_sendrecv_ring"  , &large_sendrecv_ring  },
+    {"persistent_ring"      , &persistent_ring      },
     {"rand_root_bcast"      , &rand_root_bcast      },
+    {"bcast_root_map"       , &bcast_root_map       },
     {"large_all_to_root_ptp", &large_all_to_root_ptp},
     {"large_all_to_all_ptp" , &large_all_to_all_ptp },
+    {"coll_suite"           , &coll_suite           },
+    {"overlap"              , &overlap              },
+    {"bisection_bw"         , &bisection_bw         },
+    {"rma_bw"               , &rma_bw               },
+    {"rma_gups"             , &rma_gups             },
+    {"rma_hotspot"          , &rma_hotspot          },
+    {"msg_rate"             , &msg_rate             },
+    {"shm_bw"               , &shm_bw               },
+    {"comm_create"          , &comm_create          },
+    {"match_stress"         , &match_stress         },
+    {"proto_thresholds"     , &proto_thresholds     },
+    {"dt_bw"                , &dt_bw                },
+    {"thread_msg_rate"      , &thread_msg_rate      },
     {"hello_world"          , &hello_world          },
     {NULL                   , NULL                  } /* MUST BE LAST ELEMENT */
 };